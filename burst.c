@@ -0,0 +1,75 @@
+/**@file
+ * @brief   Implementation of the tone-burst gate of the sine wave generator.
+ * @details This file implements the set of functions used to render tone bursts.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "burst.h"
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Initializes a tone-burst gate. */
+void burst_init(struct burst_descr_t * const pb, struct gen_descr_t * const pgen, const ui16_t on,
+    const ui16_t off, const bool_t reset) {
+
+    assert(pb != NULL);
+    assert(pgen != NULL);
+    assert(on > 0);
+    assert((ui32_t)on + off <= 0xFFFFu);
+
+    pb->pgen = pgen;
+    pb->snap = *pgen;
+    pb->on = (ui32_t)on << UQ016_FRAC;
+    pb->period = ((ui32_t)on + off) << UQ016_FRAC;
+    pb->pos = 0;
+    pb->reset = reset;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Renders a block of the gated generator output samples. */
+void burst_render(struct burst_descr_t * const pb, sq015_t * const pout, const ui16_t n) {
+
+    ui16_t  idx;        /* Index of the first sample of the current segment. */
+    ui16_t  cnt;        /* Number of samples of the current segment within the block. */
+
+    assert(pb != NULL);
+    assert(pout != NULL || n == 0);
+
+    for (idx = 0; idx < n; idx += cnt) {
+        const ui16_t freq = pb->pgen->freq;
+        const bool_t open = pb->pos < pb->on;
+        ui32_t  left = n - idx;     /* Number of samples to the edge of the segment. */
+
+        if (freq > 0) {
+            left = ((open ? pb->on : pb->period) - pb->pos + freq - 1) / freq;
+        }
+        cnt = left < (ui32_t)(n - idx) ? (ui16_t)left : n - idx;
+
+        if (open) {
+            gen_render(pb->pgen, pout + idx, cnt);
+        } else {
+            memset(pout + idx, 0, cnt * sizeof(*pout));
+            if (pb->reset == 0) {
+                gen_skip(pb->pgen, cnt);
+            }
+        }
+        pb->pos += (ui32_t)cnt * freq;
+
+        if (pb->pos >= pb->period) {
+            if (pb->reset) {
+                *pb->pgen = pb->snap;       /* The snapshot keeps the lookahead result of the start of the burst. */
+                pb->pos = 0;
+            } else {
+                pb->pos -= pb->period;      /* The next burst starts at the first sample past the edge. */
+            }
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
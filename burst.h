@@ -0,0 +1,71 @@
+/**@file
+ * @brief   Interface to the tone-burst gate of the sine wave generator.
+ * @details This file provides declarations for the set of functions used to render tone bursts - i.e., N cycles of the
+ *  generator output followed by M cycles of silence, repeated - and declaration of the burst descriptor data structure.
+ * @details The gate schedule is precomputed as the edges of the burst period in units of the phase: the gate is open
+ *  while the phase advanced since the start of the period is less than N cycles, and it is closed until N+M cycles.
+ *  Each segment of the schedule is rendered at once: open segments with \c gen_render, and closed ones with memset. The
+ *  number of samples of a segment is found with a single division at its edge, so the edges follow the cycles of the
+ *  tone exactly, rounded up to the next sample.
+ * @details The generator attributes are never reassigned, so the gate edges do not restart the postprocessing or run
+ *  the lookahead. Two modes are supported:
+ *  - phase continuity  -- the generator keeps running while the gate is closed, with \c gen_skip, so each burst
+ *      continues the same tone, and the postprocessing state carries over from burst to burst.
+ *  - phase reset       -- the generator stops while the gate is closed, and each burst starts from the snapshot of
+ *      the generator descriptor taken by \c burst_init, so all bursts are the same.
+ *
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef BURST_H
+#define BURST_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "sinegen.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a tone-burst descriptor.
+ */
+struct burst_descr_t {
+    struct gen_descr_t *pgen;           /**< Pointer to the gated generator. */
+    struct gen_descr_t  snap;           /**< Snapshot of the generator at the start of a burst; used by phase reset. */
+    ui32_t  on;                         /**< End of the open part of the period, in units of the phase. */
+    ui32_t  period;                     /**< End of the period, in units of the phase. */
+    ui32_t  pos;                        /**< Phase advanced since the start of the current period. */
+    bool_t  reset;                      /**< Equals to 1 for phase reset; 0 for phase continuity. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a tone-burst gate.
+ * @{
+ */
+/**@brief   Initializes a tone-burst gate.
+ * @param[in,out]   pb      -- pointer to the initialized burst descriptor object.
+ * @param[in,out]   pgen    -- pointer to the generator; it shall be configured beforehand.
+ * @param[in]       on      -- number of cycles of the tone in a burst, 1 or more.
+ * @param[in]       off     -- number of cycles of silence between bursts; on+off shall be less than 2^16.
+ * @param[in]       reset   -- if 0, keeps the phase continuity; otherwise resets the phase at each burst.
+ * @details The first burst starts with the next sample of the generator. The generator shall not be reassigned while
+ *  the gate is used; to change the tone, reassign it and call \c burst_init again.
+ * @note    The gate advances with the phase of the generator. With the frequency 0 the phase never advances, so the
+ *  gate stays open for good, and the output is the one of the paused generator with no bursts at all.
+ */
+extern void burst_init(struct burst_descr_t * const pb, struct gen_descr_t * const pgen, const ui16_t on,
+    const ui16_t off, const bool_t reset);
+
+/**@brief   Renders a block of the gated generator output samples.
+ * @param[in,out]   pb      -- pointer to a burst descriptor object.
+ * @param[out]      pout    -- pointer to the array receiving the samples.
+ * @param[in]       n       -- number of samples to render.
+ * @details The samples while the gate is open are the ones \c gen_render produces, and the samples while it is closed
+ *  are 0. If the generator is paused, the gate stays as it is.
+ */
+extern void burst_render(struct burst_descr_t * const pb, sq015_t * const pout, const ui16_t n);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* BURST_H */
@@ -73,7 +73,9 @@
  *  http://stackoverflow.com/questions/3385515/static-assert-in-c/4815532#4815532\n
  *  http://www.pixelbeat.org/programming/gcc/static_assert.html
  */
-#if (__STDC_VERSION__ >= 201112L)
+#if defined(__cplusplus)
+#define static_assert_msg(cond, msg)        static_assert(cond, #msg)
+#elif (__STDC_VERSION__ >= 201112L)
 #define static_assert_msg(cond, msg)        _Static_assert(cond, #msg)
 #else
 #define static_assert_msg(cond, msg)        struct CONCAT(__uid, __COUNTER__) { int msg : !!(cond); }
@@ -90,8 +92,30 @@
  *  block. Note that even an empty instruction (i.e., an alone ';' token) or empty code block (i.e., a couple of braces)
  *  forms the line of code. If it is necessary to use this macro in the middle of the code block, it shall be surrounded
  *  with braces forming a nested code block.
+ * @note    In C++ the \c static_assert is a keyword, so this macro is not defined there.
  */
+#ifndef __cplusplus
 #define static_assert(cond)     static_assert_msg(cond, _)
+#endif
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Macros for inline functions.
+ * @{
+ */
+/**@brief   Declares a function defined in a header file, to be expanded in place of its calls.
+ * @details The function gets the internal linkage, so each translation unit including the header has its own copy if
+ *  the compiler does not expand the calls. The \c inline keyword is not defined in ANSI C89 / ISO C90; the GNU
+ *  compiler accepts the alternate keyword \c \__inline__ in all language modes, and other compilers get a plain static
+ *  function.
+ */
+#if defined(__cplusplus) || (__STDC_VERSION__ >= 199901L)
+#define INLINE          static inline
+#elif defined(__GNUC__)
+#define INLINE          static __inline__
+#else
+#define INLINE          static
+#endif
 /**@}*/
 
 /*--------------------------------------------------------------------------------------------------------------------*/
@@ -1,6 +1,7 @@
 /**@file
  * @brief   Interface to arithmetic functions on fixed point data types.
- * @details This file provides declarations of arithmetic functions in the field of fixed point numbers.
+ * @details This file provides arithmetic functions in the field of fixed point numbers. They are defined inline, since
+ *  they are called for each sample.
  * @author  Alexander A. Strelets
  * @version 1.0
  * @date    October, 2016
@@ -24,7 +25,15 @@
  *  with resolution of 1/2^16.
  * @details The product is rounded down to the nearest value with resolution of 1/2^16.
  */
-extern uq016_t qmul_uq016(const uq016_t a, const uq016_t b);
+INLINE uq016_t qmul_uq016(const uq016_t a, const uq016_t b);
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+/* Returns the product of two fixed point values, unsigned fixed point 0.16-bit version. */
+INLINE uq016_t qmul_uq016(const uq016_t a, const uq016_t b) {
+    return ((ui32_t)a * (ui32_t)b) >> UQ016_FRAC;
+}
+/**@endcond*/
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 
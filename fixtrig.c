@@ -11,6 +11,8 @@
 /*--------------------------------------------------------------------------------------------------------------------*/
 #include "fixtrig.h"
 #include "fixmath.h"
+#include <assert.h>
+#include <stddef.h>
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**@brief   Returns the sine given a momentary phase, unsigned fixed point 0.16-bit version.
@@ -91,7 +93,7 @@ static uq016_t qsin_uq016(const uq016_t phi);
  * @note    The momentary amplitude value 1 exactly cannot be represented as a UQ0.16 value. However, it is actually
  *  never reached taking into account the resolution of \p phi.
  */
-static const uq016_t qsin_lut[] = {
+const uq016_t qsin_lut[] = {
     0x0000, 0x0192, 0x0324, 0x04B6, 0x0648, 0x07DA, 0x096C, 0x0AFE,
     0x0C90, 0x0E21, 0x0FB3, 0x1144, 0x12D5, 0x1466, 0x15F7, 0x1787,
     0x1918, 0x1AA8, 0x1C38, 0x1DC7, 0x1F56, 0x20E5, 0x2274, 0x2402,
@@ -227,3 +229,105 @@ sq015_t msin_sq015(const uq016_t phi, const uq016_t att) {
 }
 
 /*--------------------------------------------------------------------------------------------------------------------*/
+/* Renders a run of the modulated sine over a regularly advancing phase, signed fixed point 0.15-bit version. */
+uq016_t msin_run_sq015(sq015_t * const pout, uq016_t phi, const uq016_t dphi, const uq016_t att, const ui16_t n) {
+
+    /**@cond false*/
+    #define _PI2        (0x4000u)                       /* Container value for UQ0.16 value 0.25 (pi/2 radian). */
+    #define _PI         (0x8000u)                       /* Container value for UQ0.16 value 0.5 (pi radian). */
+    #define _COEF_BIT   (6)                             /* Width of the linear interpolation coefficient. */
+    #define _COEF_RANK  (POW2(_COEF_BIT))               /* Number of different phi values between LUT entries. */
+    #define _COEF_MASK  (BIT_MASK(_COEF_BIT))           /* Bit mask for linear interpolation coefficient. */
+    #define _RUN_MAX    (_COEF_RANK / 4)                /* Largest increment giving at least 4 samples per segment. */
+    #define _1          (0x0000u)                       /* Container value for UQ0.16 value 1.0
+                                                         * represented as 0.0 modulo 1.0. */
+    /**@endcond*/
+
+    ui16_t  idx = 0;    /* Index of the current sample. */
+
+    assert(pout != NULL || n == 0);
+
+    if (dphi == 0 || dphi > _RUN_MAX) {     /* Segments are too short to pay for the setup. */
+        for (; idx < n; ++idx) {
+            pout[idx] = msin_sq015(phi, att);
+            phi += dphi;
+        }
+        return phi;
+    }
+
+    while (idx < n) {
+        uq016_t phi1 = phi;     /* Value of phi brought into the first quadrant - i.e., the range [0; pi/2) radian. */
+        bool_t  neg = 0;        /* Equals to 1 if sin(phi) < 0; equals to 0 if sin(phi) >= 0. */
+        bool_t  back = 0;       /* Equals to 1 if phi1 decreases while phi increases. */
+        ui16_t  key;            /* Left side key into the phase-to-sine LUT. */
+        ui16_t  frac;           /* Position of phi1 between the knots, in units of the phase resolution. */
+        ui16_t  cnt;            /* Number of samples on the current segment. */
+        uq022_t acc0, acc1;     /* Left and right side values taken from the LUT with linear weight, not truncated. */
+        uq022_t dacc0, dacc1;   /* Changes of acc0 and acc1 per sample. */
+
+        if ((phi & ~_PI) == _PI2) {         /* Both pi/2 and 3*pi/2 are evaluated as the special cases. */
+            pout[idx++] = msin_sq015(phi, att);
+            phi += dphi;
+            continue;
+        }
+        if (phi >= _PI) {
+            phi1 -= _PI;
+            neg = 1;
+        }
+        if (phi1 > _PI2) {
+            phi1 = _PI - phi1;
+            back = 1;
+        }
+        key = phi1 >> _COEF_BIT;
+        frac = phi1 & _COEF_MASK;
+        cnt = (back ? frac : _COEF_MASK - frac) / dphi + 1;     /* phi1 stays within the quadrant on the segment. */
+        if (cnt > n - idx) {
+            cnt = n - idx;
+        }
+
+        /* msin_sq015 takes floor(lut[key]*(1-coef)) + floor(lut[key+1]*coef) where coef = frac/64 and lut[256] = 1.0;
+         * both products are exact in UQ0.22, so truncating each accumulator to UQ0.16 gives the same terms. When phi1
+         * moves back onto 0, the result is 0 whatever the sign is. */
+        acc0 = (uq022_t)qsin_lut[key] * (_COEF_RANK - frac);
+        acc1 = (key + 1 < ARRAY_SIZE(qsin_lut) ? (uq022_t)qsin_lut[key + 1] : POW2(UQ016_FRAC)) * frac;
+        dacc0 = (uq022_t)qsin_lut[key] * dphi;
+        dacc1 = (key + 1 < ARRAY_SIZE(qsin_lut) ? (uq022_t)qsin_lut[key + 1] : POW2(UQ016_FRAC)) * dphi;
+        phi += (ui16_t)(cnt * dphi);
+
+        for (; cnt > 0; --cnt) {
+            uq016_t usin = uq016_from_uq022(acc0) + uq016_from_uq022(acc1);     /* Absolute value of sin(phi). */
+            bool_t  lsb;        /* Value of LSB of 0.16-bit value returned by sin(phi) before rounding to 0.15-bit. */
+            sq015_t ssin;       /* Signed 0.15-bit absolute value of sin(phi). */
+
+            if (att > 0) {
+                usin = qmul_uq016(usin, _1 - att);
+            }
+            lsb = usin & 1;
+            ssin = sq015_from_uq016(usin);
+            if (lsb && ssin < 0x7FFF) {
+                ++ssin;
+            }
+            pout[idx++] = neg ? -ssin : +ssin;
+
+            if (back) {
+                acc0 += dacc0;
+                acc1 -= dacc1;
+            } else {
+                acc0 -= dacc0;
+                acc1 += dacc1;
+            }
+        }
+    }
+
+    return phi;
+
+    #undef  _PI2
+    #undef  _PI
+    #undef  _COEF_BIT
+    #undef  _COEF_RANK
+    #undef  _COEF_MASK
+    #undef  _RUN_MAX
+    #undef  _1
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -81,6 +81,29 @@
  */
 extern sq015_t msin_sq015(const uq016_t phi, const uq016_t att);
 
+/**@brief   Renders a run of the modulated sine over a regularly advancing phase, signed fixed point 0.15-bit version.
+ * @param[out]  pout    -- pointer to the buffer receiving \p n samples.
+ * @param[in]   phi     -- momentary phase of the first sample.
+ * @param[in]   dphi    -- phase increment per sample.
+ * @param[in]   att     -- momentary attenuation factor, constant over the run.
+ * @param[in]   n       -- number of samples.
+ * @return  The momentary phase following the last sample, phi+n*dphi modulo 2*pi.
+ * @details The k-th sample equals to msin_sq015(phi+k*dphi, att) bit-exactly. At low increments the phase stays between
+ *  the same two knots of the lookup table for many samples. On such a segment both weighted knot values of the linear
+ *  interpolation are kept in UQ0.22 accumulators, which equal to the products of \c msin_sq015 before the truncation,
+ *  and advance by a precomputed delta per sample. The lookup, the quadrant folding and the interpolation products are
+ *  evaluated only once per segment; the attenuation and the rounding stay per sample.
+ */
+extern uq016_t msin_run_sq015(sq015_t * const pout, uq016_t phi, const uq016_t dphi, const uq016_t att,
+    const ui16_t n);
+
+/**@brief   Phase-to-sine lookup table used by \c msin_sq015.
+ * @details The table has 256 entries with the values of sin(phi) in UQ0.16 for phi = key*pi/512, key = 0...255. It is
+ *  exported to verify implementations which shall reproduce \c msin_sq015 bit-exactly, such as the table built at
+ *  compile time in \c sinegen.hpp. See \c fixtrig.c for the details.
+ */
+extern const uq016_t qsin_lut[];
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 
 #endif /* FIXTRIG_H */
@@ -0,0 +1,153 @@
+/**@file
+ * @brief   Implementation of the bank of sine wave generators.
+ * @details This file implements the set of functions used to render the output of several sine wave generators into
+ *  interleaved multi-channel frames.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "genbank.h"
+#include "sampfmt.h"
+#include <assert.h>
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Number of frames in a tile.
+ * @details The tile of BANK_MAX_CHANS channels takes 2 KB of SQ0.15 samples, and the corresponding part of the output
+ *  buffer takes at most 4 KB, so both stay in the first level data cache while the tile is transposed.
+ */
+#define BANK_TILE   (16)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+static void bank_store(sq015_t (* const ptile)[BANK_TILE], const ui8_t chans, const ui8_t type, void * const pout,
+    const ui16_t cnt);
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Initializes a generator bank. */
+void bank_init(struct bank_descr_t * const pbank, struct gen_descr_t * const pgens, const ui8_t chans) {
+
+    ui8_t   chan;       /* Index of the current channel. */
+
+    assert(pbank != NULL);
+    assert(pgens != NULL);
+    assert(chans > 0 && chans <= BANK_MAX_CHANS);
+
+    pbank->pgens = pgens;
+    pbank->chans = chans;
+
+    for (chan = 0; chan < chans; ++chan) {
+        gen_init(&pgens[chan]);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns a cache of the lookahead results to all generators of a bank. */
+void bank_set_cache(struct bank_descr_t * const pbank, struct ppc_descr_t * const pc) {
+
+    ui8_t   chan;       /* Index of the current channel. */
+
+    assert(pbank != NULL);
+    assert(pbank->chans > 0 && pbank->chans <= BANK_MAX_CHANS);
+
+    for (chan = 0; chan < pbank->chans; ++chan) {
+        gen_set_cache(&pbank->pgens[chan], pc);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Renders a block of interleaved frames. */
+void bank_render(struct bank_descr_t * const pbank, const ui8_t type, void * const pout, const ui16_t n) {
+
+    sq015_t tile[BANK_MAX_CHANS][BANK_TILE];    /* Samples of the current tile, one row per channel. */
+    size_t  frame;                              /* Size of a frame, in bytes. */
+    ui8_t   chan;                               /* Index of the current channel. */
+    ui16_t  idx;                                /* Index of the first frame of the current tile. */
+    ui16_t  cnt;                                /* Number of frames in the current tile. */
+
+    assert(pbank != NULL);
+    assert(pbank->chans > 0 && pbank->chans <= BANK_MAX_CHANS);
+    assert(pout != NULL || n == 0);
+
+    frame = (size_t)fmt_size(type) * pbank->chans;
+
+    for (idx = 0; idx < n; idx += cnt) {
+        cnt = n - idx < BANK_TILE ? n - idx : BANK_TILE;
+        for (chan = 0; chan < pbank->chans; ++chan) {
+            gen_render(&pbank->pgens[chan], tile[chan], cnt);
+        }
+        bank_store(tile, pbank->chans, type, (ui8_t *)pout + idx * frame, cnt);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void bank_store(sq015_t (* const ptile)[BANK_TILE], const ui8_t chans, const ui8_t type, void * const pout,
+    const ui16_t cnt) {
+
+    /* The tile is read by columns and the frames are written in order, one sample after another. */
+
+    ui16_t  idx;        /* Index of the current frame within the tile. */
+    ui8_t   chan;       /* Index of the current channel. */
+
+    assert(ptile != NULL);
+    assert(pout != NULL || cnt == 0);
+
+    switch (type) {
+    case FMT_SQ015: {
+        sq015_t * py = pout;
+        for (idx = 0; idx < cnt; ++idx) {
+            for (chan = 0; chan < chans; ++chan) {
+                fmt_put(FMT_SQ015, ptile[chan][idx], py++);
+            }
+        }
+        break;
+    }
+    case FMT_F32: {
+        float * py = pout;
+        for (idx = 0; idx < cnt; ++idx) {
+            for (chan = 0; chan < chans; ++chan) {
+                fmt_put(FMT_F32, ptile[chan][idx], py++);
+            }
+        }
+        break;
+    }
+    case FMT_S24: {
+        ui8_t * py = pout;
+        for (idx = 0; idx < cnt; ++idx) {
+            for (chan = 0; chan < chans; ++chan) {
+                fmt_put(FMT_S24, ptile[chan][idx], py);
+                py += 3;
+            }
+        }
+        break;
+    }
+    case FMT_S32: {
+        si32_t * py = pout;
+        for (idx = 0; idx < cnt; ++idx) {
+            for (chan = 0; chan < chans; ++chan) {
+                fmt_put(FMT_S32, ptile[chan][idx], py++);
+            }
+        }
+        break;
+    }
+    case FMT_OB16: {
+        ui16_t * py = pout;
+        for (idx = 0; idx < cnt; ++idx) {
+            for (chan = 0; chan < chans; ++chan) {
+                fmt_put(FMT_OB16, ptile[chan][idx], py++);
+            }
+        }
+        break;
+    }
+    default:
+        assert(0);
+    }
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,71 @@
+/**@file
+ * @brief   Interface to the bank of sine wave generators.
+ * @details This file provides declarations for the set of functions used to render the output of several sine wave
+ *  generators into interleaved multi-channel frames, and declaration of the generator bank descriptor data structure.
+ * @details Each generator of the bank produces one channel of the output. Frames are composed of samples of all the
+ *  channels following in the order of generators in the bank. Samples are rendered in tiles of several frames: first
+ *  each generator renders its part of the tile, and then the tile is transposed while it is stored into the output
+ *  frames, so the output buffer is written sequentially and only once.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef GENBANK_H
+#define GENBANK_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "sinegen.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Maximum number of generators in a bank.
+ */
+#define BANK_MAX_CHANS  (64)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a generator bank descriptor.
+ * @details The bank does not own the generators: it refers to an array of generator descriptors allocated by the
+ *  application. Generators may be configured individually with functions \c gen_set_xxx at any time between calls to
+ *  \c bank_render.
+ */
+struct bank_descr_t {
+    struct gen_descr_t *pgens;      /**< Pointer to the array of generators, one per channel. */
+    ui8_t   chans;                  /**< Number of generators in the bank, from 1 to BANK_MAX_CHANS. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a generator bank.
+ * @{
+ */
+/**@brief   Initializes a generator bank.
+ * @param[in,out]   pbank   -- pointer to the initialized bank descriptor object.
+ * @param[in,out]   pgens   -- pointer to the array of generator descriptors.
+ * @param[in]       chans   -- number of generators in the array \p pgens.
+ * @details Each generator of the bank is initialized with \c gen_init.
+ */
+extern void bank_init(struct bank_descr_t * const pbank, struct gen_descr_t * const pgens, const ui8_t chans);
+
+/**@brief   Assigns a cache of the lookahead results to all generators of a bank.
+ * @param[in,out]   pbank   -- pointer to a bank descriptor object.
+ * @param[in,out]   pc      -- pointer to an initialized cache, see \c ppcache.h; NULL to detach the cache.
+ * @details The channels at the same level share the lookahead results, see \c gen_set_cache. Generators
+ *  reinitialized with \c bank_init are detached from the cache.
+ */
+extern void bank_set_cache(struct bank_descr_t * const pbank, struct ppc_descr_t * const pc);
+
+/**@brief   Renders a block of interleaved frames.
+ * @param[in,out]   pbank   -- pointer to a bank descriptor object.
+ * @param[in]       type    -- format of output samples, one of FMT_xxx; see \c sampfmt.h.
+ * @param[out]      pout    -- pointer to the first frame of the output buffer.
+ * @param[in]       n       -- number of frames to render.
+ * @details The sample of the channel c in the frame f is stored at the position (f*chans + c) of the output buffer,
+ *  counting in samples of the given format. The result is the same as if each generator rendered its channel with
+ *  \c gen_render_fmt.
+ */
+extern void bank_render(struct bank_descr_t * const pbank, const ui8_t type, void * const pout, const ui16_t n);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* GENBANK_H */
@@ -0,0 +1,125 @@
+/**@file
+ * @brief   Implementation of the harmonic series generator.
+ * @details This file implements the set of functions used to manipulate the harmonic series generator.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "harmgen.h"
+#include "fixtrig.h"
+#include <assert.h>
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Number of samples in a tile.
+ * @details The tile of one partial and the sums of the tile take 384 bytes, so they stay in the first level data cache
+ *  while the partials are added up.
+ */
+#define HARM_TILE   (64)
+
+/**@brief   Attenuation of a silent partial.
+ */
+#define HARM_MUTE   (0xFFFFu)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Initializes a harmonic series generator. */
+void harm_init(struct harm_descr_t * const ph) {
+
+    ui8_t   k;          /* Index of a partial. */
+
+    assert(ph != NULL);
+
+    ph->freq = 0;
+    ph->phi = 0;
+    ph->order = 1;
+    for (k = 0; k < HARM_MAX; ++k) {
+        ph->atts[k] = HARM_MUTE;
+        ph->offs[k] = 0;
+    }
+    ph->atts[0] = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the frequency of the fundamental. */
+void harm_set_freq(struct harm_descr_t * const ph, const uq016_t freq) {
+
+    assert(ph != NULL);
+    assert(freq <= 0x4000);
+
+    ph->freq = freq;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the phase of the fundamental. */
+void harm_set_phi(struct harm_descr_t * const ph, const uq016_t phi) {
+
+    assert(ph != NULL);
+
+    ph->phi = phi;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the attenuation and the phase offset of a partial. */
+void harm_set_partial(struct harm_descr_t * const ph, const ui8_t k, const uq016_t att, const uq016_t off) {
+
+    assert(ph != NULL);
+    assert(k >= 1 && k <= HARM_MAX);
+
+    ph->atts[k - 1] = att;
+    ph->offs[k - 1] = off;
+
+    ph->order = HARM_MAX;
+    while (ph->order > 0 && ph->atts[ph->order - 1] == HARM_MUTE) {
+        --(ph->order);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Renders a block of the harmonic generator output samples. */
+void harm_render(struct harm_descr_t * const ph, sq015_t * const pout, const ui16_t n) {
+
+    /**@cond false*/
+    #define _1P     (0x7FFFL)       /* Container value for SQ0.15 value +1.0-1/2^15. */
+    #define _1N     (-0x8000L)      /* Container value for SQ0.15 value -1.0. */
+    /**@endcond*/
+
+    sq015_t part[HARM_TILE];    /* Samples of a partial over the current tile. */
+    si32_t  sum[HARM_TILE];     /* Sums of the partials over the current tile. */
+    ui16_t  idx;                /* Index of the first sample of the current tile. */
+    ui16_t  cnt;                /* Number of samples in the current tile. */
+    ui16_t  i;                  /* Index of a sample within the tile. */
+    ui8_t   k;                  /* Index of a partial. */
+
+    assert(ph != NULL);
+    assert(pout != NULL || n == 0);
+
+    for (idx = 0; idx < n; idx += cnt) {
+        cnt = n - idx < HARM_TILE ? n - idx : HARM_TILE;
+        for (i = 0; i < cnt; ++i) {
+            sum[i] = 0;
+        }
+        for (k = 0; k < ph->order; ++k) {
+            if (ph->atts[k] == HARM_MUTE) {
+                continue;
+            }
+            /* The phase of the partial k+1 is (k+1)*phi modulo 1, and it advances by (k+1)*freq modulo 1. */
+            msin_run_sq015(part, (uq016_t)((ui16_t)(k + 1) * ph->phi + ph->offs[k]),
+                (uq016_t)((ui16_t)(k + 1) * ph->freq), ph->atts[k], cnt);
+            for (i = 0; i < cnt; ++i) {
+                sum[i] += part[i];
+            }
+        }
+        for (i = 0; i < cnt; ++i) {
+            pout[idx + i] = (sq015_t)(sum[i] > _1P ? _1P : sum[i] < _1N ? _1N : sum[i]);
+        }
+        ph->phi += (uq016_t)(cnt * (ui32_t)ph->freq);
+    }
+
+    #undef  _1P
+    #undef  _1N
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
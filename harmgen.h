@@ -0,0 +1,86 @@
+/**@file
+ * @brief   Interface to the harmonic series generator.
+ * @details This file provides declarations for the set of functions used to manipulate the harmonic series generator,
+ *  and declaration of the harmonic generator descriptor data structure.
+ * @details The harmonic generator produces the sum of a fundamental tone and its harmonics - i.e., the partials of the
+ *  orders k = 1...HARM_MAX at frequencies k*freq, each with its own attenuation and phase offset. All the partials are
+ *  driven by a single phase accumulator of the fundamental: the phase of the partial k is k*phi plus its offset, modulo
+ *  2*pi, so the partials never drift apart, and a change of the frequency or the phase affects all of them at once.
+ * @details Each partial is evaluated with \c msin_run_sq015 over a tile of samples, and the partials are summed with
+ *  saturation to SQ0.15. The postprocessing of \c sinegen.h is not applied.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef HARMGEN_H
+#define HARMGEN_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "fixtypes.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Maximum order of a partial of the harmonic generator.
+ */
+#define HARM_MAX    (16)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a harmonic series generator descriptor.
+ */
+struct harm_descr_t {
+    uq016_t freq;               /**< Frequency of the fundamental. */
+    uq016_t phi;                /**< Momentary phase of the fundamental. */
+    ui8_t   order;              /**< Highest order of an audible partial; 0 if all the partials are silent. */
+    uq016_t atts[HARM_MAX];     /**< Attenuation of the partial of the order k, at the index k-1. */
+    uq016_t offs[HARM_MAX];     /**< Phase offset of the partial of the order k, at the index k-1. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a harmonic series generator.
+ * @{
+ */
+/**@brief   Initializes a harmonic series generator.
+ * @param[in,out]   ph  -- pointer to the initialized generator descriptor object.
+ * @details During initialization the frequency and the phase are set to 0, the fundamental is set to no attenuation
+ *  and no phase offset, and all the harmonics are silent - i.e., their attenuation is set to 1-1/2^16.
+ */
+extern void harm_init(struct harm_descr_t * const ph);
+
+/**@brief   Assigns the frequency of the fundamental.
+ * @param[in,out]   ph      -- pointer to a generator descriptor object.
+ * @param[in]       freq    -- a new value of the frequency; see \c gen_set_freq.
+ * @note    The partial of the order k has the frequency k*freq modulo 1. Partials above the Nyquist frequency 0.5 are
+ *  aliased, and the ones above 0.25 are rendered with fewer than 4 samples per period, as no single generator is.
+ */
+extern void harm_set_freq(struct harm_descr_t * const ph, const uq016_t freq);
+
+/**@brief   Assigns the phase of the fundamental.
+ * @param[in,out]   ph      -- pointer to a generator descriptor object.
+ * @param[in]       phi     -- a new value of the phase; see \c gen_set_phi.
+ */
+extern void harm_set_phi(struct harm_descr_t * const ph, const uq016_t phi);
+
+/**@brief   Assigns the attenuation and the phase offset of a partial.
+ * @param[in,out]   ph      -- pointer to a generator descriptor object.
+ * @param[in]       k       -- order of the partial, from 1 for the fundamental to HARM_MAX.
+ * @param[in]       att     -- attenuation of the partial; see \c gen_set_att. The value 1-1/2^16 silences it.
+ * @param[in]       off     -- phase offset of the partial, added to k*phi.
+ */
+extern void harm_set_partial(struct harm_descr_t * const ph, const ui8_t k, const uq016_t att, const uq016_t off);
+
+/**@brief   Renders a block of the harmonic generator output samples.
+ * @param[in,out]   ph      -- pointer to a generator descriptor object.
+ * @param[out]      pout    -- pointer to the array receiving the generated samples.
+ * @param[in]       n       -- number of samples to render.
+ * @details The sample t of the block is the sum of msin_sq015(k*(phi+t*freq)+off[k], att[k]) over the audible
+ *  partials, saturated to the range [-1.0; +1.0-1/2^15]. Silent partials are not evaluated. The phase of the
+ *  fundamental is advanced by n*freq.
+ * @note    The sum saturates unless the amplitudes of the partials, (1-att[k]), add up to less than 1.
+ */
+extern void harm_render(struct harm_descr_t * const ph, sq015_t * const pout, const ui16_t n);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* HARMGEN_H */
@@ -0,0 +1,621 @@
+/**@file
+ * @brief   Implementation of the asynchronous capture sink.
+ * @details This file implements the set of functions used to write the captured generator output into a file without
+ *  blocking the producer on the disk.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _GNU_SOURCE
+
+#include "capsink.h"
+#include <linux/io_uring.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Number of writer threads of the SINK_THREADS backend.
+ */
+#define SINK_WORKERS    (4)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+
+/* Write request queued for the writer threads. */
+struct sink_req_t {
+    int     chunk;      /* Index of the chunk. */
+    off_t   off;        /* Offset in the file. */
+    size_t  len;        /* Number of bytes to write. */
+};
+
+/* Capture sink. */
+struct sink_t {
+    int     fd;                                 /* Output file descriptor. */
+    int     tail_fd;                            /* Descriptor of the same file without O_DIRECT, for the tails of
+                                                 * short writes, which are not aligned; equals to fd if not direct. */
+    int     backend;                            /* Backend used. */
+    int     err;                                /* Value of errno at the first failure; 0 if none. */
+    off_t   offset;                             /* Offset in the file of the next chunk to submit. */
+    off_t   total;                              /* Total number of bytes passed to the sink. */
+    unsigned char * chunks[SINK_DEPTH];         /* Pool of chunks. */
+    int     cur;                                /* Index of the chunk being filled; -1 if none. */
+    size_t  fill;                               /* Number of bytes in the chunk being filled. */
+    int     frees[SINK_DEPTH];                  /* Stack of indices of free chunks. */
+    int     nfree;                              /* Number of free chunks. */
+    struct sink_stats_t stats;                  /* Statistics. */
+    /* SINK_URING backend. */
+    int     ring;                               /* File descriptor of the io_uring instance. */
+    void *  sq_ptr;                             /* Mapping of the submission queue ring. */
+    size_t  sq_size;                            /* Size of the submission queue ring mapping. */
+    void *  cq_ptr;                             /* Mapping of the completion queue ring. */
+    size_t  cq_size;                            /* Size of the completion queue ring mapping. */
+    struct io_uring_sqe * sqes;                 /* Mapping of the submission queue entries. */
+    size_t  sqes_size;                          /* Size of the submission queue entries mapping. */
+    unsigned int * sq_tail;                     /* Tail of the submission queue. */
+    unsigned int * sq_mask;                     /* Mask of indices of the submission queue. */
+    unsigned int * sq_array;                    /* Array of indices of the submission queue entries. */
+    unsigned int * cq_head;                     /* Head of the completion queue. */
+    unsigned int * cq_tail;                     /* Tail of the completion queue. */
+    unsigned int * cq_mask;                     /* Mask of indices of the completion queue. */
+    struct io_uring_cqe * cqes;                 /* Completion queue entries. */
+    struct iovec iov[SINK_DEPTH];               /* Vectors of writes in flight, one per chunk. */
+    off_t   offs[SINK_DEPTH];                   /* Offsets of writes in flight, one per chunk. */
+    /* SINK_THREADS backend. */
+    pthread_t   workers[SINK_WORKERS];          /* Writer threads. */
+    int     nworkers;                           /* Number of writer threads started. */
+    pthread_mutex_t lock;                       /* Lock protecting the queue, the free stack and the error. */
+    pthread_cond_t  work;                       /* Signalled when a request is queued or the sink is stopped. */
+    pthread_cond_t  done;                       /* Signalled when a chunk is freed. */
+    struct sink_req_t queue[SINK_DEPTH];        /* Queue of write requests. */
+    int     qhead;                              /* Index of the first request in the queue. */
+    int     qcount;                             /* Number of requests in the queue. */
+    int     stop;                               /* Set to 1 when the writer threads shall exit. */
+};
+
+static double sink_now(void);
+static int sink_pwrite(const struct sink_t * const ps, const unsigned char * pdata, size_t len, off_t off);
+static int sink_get(struct sink_t * const ps);
+static void sink_submit(struct sink_t * const ps, const size_t len);
+static int sink_drain(struct sink_t * const ps);
+static int uring_setup(struct sink_t * const ps);
+static int uring_reap(struct sink_t * const ps, const int wait);
+static void uring_free(struct sink_t * const ps);
+static int threads_setup(struct sink_t * const ps);
+static void * threads_worker(void * const arg);
+
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Creates a capture sink writing into a new file. */
+struct sink_t * sink_open(const char * const path, const int backend) {
+
+    struct sink_t * ps;     /* New sink. */
+    int     idx;            /* Index of a chunk. */
+
+    assert(path != NULL);
+    assert(backend == SINK_SYNC || backend == SINK_URING || backend == SINK_THREADS);
+
+    ps = calloc(1, sizeof(*ps));
+    if (ps == NULL) {
+        return NULL;
+    }
+    ps->backend = backend;
+    ps->cur = -1;
+    ps->ring = -1;
+
+    ps->fd = -1;
+    if (backend != SINK_SYNC) {
+        ps->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        ps->stats.direct = ps->fd >= 0;
+    }
+    if (ps->fd < 0) {
+        ps->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (ps->fd < 0) {
+        free(ps);
+        return NULL;
+    }
+    ps->tail_fd = ps->fd;
+    if (ps->stats.direct) {
+        ps->tail_fd = open(path, O_WRONLY);
+        if (ps->tail_fd < 0) {
+            ps->err = errno;
+        }
+    }
+
+    if (ps->err == 0 && backend != SINK_SYNC) {
+        for (idx = 0; idx < SINK_DEPTH; ++idx) {
+            void * pchunk = NULL;
+            if (posix_memalign(&pchunk, SINK_ALIGN, SINK_CHUNK) != 0) {
+                ps->err = ENOMEM;
+                break;
+            }
+            ps->chunks[idx] = pchunk;
+            ps->frees[ps->nfree++] = idx;
+        }
+        if (ps->err == 0 && backend == SINK_URING && uring_setup(ps) != 0) {
+            ps->backend = SINK_THREADS;
+        }
+        if (ps->err == 0 && ps->backend == SINK_THREADS && threads_setup(ps) != 0) {
+            ps->err = errno;
+        }
+    }
+    if (ps->err != 0) {     /* No writes are submitted yet, and no writer threads run, so nothing is to be drained. */
+        const int err = ps->err;
+        for (idx = 0; idx < SINK_DEPTH; ++idx) {
+            free(ps->chunks[idx]);
+        }
+        if (ps->tail_fd >= 0 && ps->tail_fd != ps->fd) {
+            close(ps->tail_fd);
+        }
+        close(ps->fd);
+        free(ps);
+        errno = err;
+        return NULL;
+    }
+    ps->stats.backend = ps->backend;
+
+    return ps;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Passes data to a capture sink. */
+int sink_write(struct sink_t * const ps, const void * const pdata, const size_t size) {
+
+    const unsigned char * pbyte = pdata;    /* Pointer to the data not yet accepted. */
+    size_t  left = size;                    /* Size of the data not yet accepted. */
+
+    assert(ps != NULL);
+    assert(pdata != NULL || size == 0);
+
+    if (ps->backend == SINK_SYNC) {
+        if (sink_pwrite(ps, pbyte, left, ps->total) != 0) {
+            return -1;
+        }
+        ps->total += size;
+        return 0;
+    }
+
+    while (left > 0) {
+        size_t  cnt;        /* Number of bytes copied into the current chunk. */
+        if (ps->cur < 0) {
+            ps->cur = sink_get(ps);
+            ps->fill = 0;
+            if (ps->cur < 0) {
+                return -1;
+            }
+        }
+        cnt = SINK_CHUNK - ps->fill < left ? SINK_CHUNK - ps->fill : left;
+        memcpy(ps->chunks[ps->cur] + ps->fill, pbyte, cnt);
+        ps->fill += cnt;
+        pbyte += cnt;
+        left -= cnt;
+        if (ps->fill == SINK_CHUNK) {
+            sink_submit(ps, SINK_CHUNK);
+        }
+    }
+    ps->total += size;
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Completes all writes and closes a capture sink. */
+int sink_close(struct sink_t * const ps, struct sink_stats_t * const pstats) {
+
+    int     err;        /* Status of the sink. */
+    int     idx;        /* Index of a chunk or a thread. */
+
+    assert(ps != NULL);
+
+    if (ps->cur >= 0 && ps->fill > 0) {
+        size_t len = (ps->fill + SINK_ALIGN - 1) / SINK_ALIGN * SINK_ALIGN;   /* Padded length of the last chunk. */
+        memset(ps->chunks[ps->cur] + ps->fill, 0, len - ps->fill);
+        sink_submit(ps, len);
+    }
+    if (ps->backend != SINK_SYNC) {
+        sink_drain(ps);
+    }
+
+    if (ps->backend == SINK_URING) {
+        uring_free(ps);
+    }
+    if (ps->nworkers > 0) {
+        pthread_mutex_lock(&ps->lock);
+        ps->stop = 1;
+        pthread_cond_broadcast(&ps->work);
+        pthread_mutex_unlock(&ps->lock);
+        for (idx = 0; idx < ps->nworkers; ++idx) {
+            pthread_join(ps->workers[idx], NULL);
+        }
+        pthread_mutex_destroy(&ps->lock);
+        pthread_cond_destroy(&ps->work);
+        pthread_cond_destroy(&ps->done);
+    }
+
+    if (ps->err == 0 && ps->offset != ps->total && ftruncate(ps->fd, ps->total) != 0) {
+        ps->err = errno;
+    }
+    if (ps->tail_fd != ps->fd && close(ps->tail_fd) != 0 && ps->err == 0) {
+        ps->err = errno;
+    }
+    if (close(ps->fd) != 0 && ps->err == 0) {
+        ps->err = errno;
+    }
+
+    err = ps->err;
+    if (pstats != NULL) {
+        *pstats = ps->stats;
+    }
+    for (idx = 0; idx < SINK_DEPTH; ++idx) {
+        free(ps->chunks[idx]);
+    }
+    free(ps);
+
+    if (err != 0) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+double sink_now(void) {
+
+    struct timespec ts;     /* Current time of the monotonic clock. */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int sink_pwrite(const struct sink_t * const ps, const unsigned char * pdata, size_t len, off_t off) {
+
+    int     fd = ps->fd;    /* The first write is aligned; the rest after a short write may be not. */
+
+    while (len > 0) {
+        ssize_t res = pwrite(fd, pdata, len, off);
+        fd = ps->tail_fd;
+        if (res < 0 && errno != EINTR) {
+            return -1;
+        }
+        if (res == 0) {         /* Nothing written, so retrying would loop forever. */
+            errno = EIO;
+            return -1;
+        }
+        if (res > 0) {
+            pdata += res;
+            len -= res;
+            off += res;
+        }
+    }
+
+    return 0;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int sink_get(struct sink_t * const ps) {
+
+    int     idx;        /* Index of the free chunk, or -1 if the sink has failed. */
+    int     err;        /* Error of the sink. */
+    double  start;      /* Time when the wait began. */
+
+    if (ps->backend == SINK_URING) {
+        int     res = uring_reap(ps, 0);
+        if (ps->nfree == 0 && res == 0) {
+            start = sink_now();
+            ++(ps->stats.waits);
+            while (ps->nfree == 0 && res == 0) {
+                res = uring_reap(ps, 1);
+            }
+            ps->stats.wait += sink_now() - start;
+        }
+        if (ps->err != 0 || ps->nfree == 0) {
+            errno = ps->err != 0 ? ps->err : EIO;
+            return -1;
+        }
+        return ps->frees[--(ps->nfree)];
+    }
+
+    pthread_mutex_lock(&ps->lock);
+    if (ps->nfree == 0) {
+        start = sink_now();
+        ++(ps->stats.waits);
+        while (ps->nfree == 0) {
+            pthread_cond_wait(&ps->done, &ps->lock);
+        }
+        ps->stats.wait += sink_now() - start;
+    }
+    err = ps->err;          /* Written by the writer threads under the lock. */
+    idx = err == 0 ? ps->frees[--(ps->nfree)] : -1;
+    pthread_mutex_unlock(&ps->lock);
+
+    if (err != 0) {
+        errno = err;
+    }
+    return idx;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void sink_submit(struct sink_t * const ps, const size_t len) {
+
+    const int chunk = ps->cur;      /* Index of the submitted chunk. */
+    long    res;                    /* Result of the submission. */
+
+    if (ps->backend == SINK_URING) {
+        unsigned int tail = *ps->sq_tail;
+        unsigned int idx = tail & *ps->sq_mask;
+        struct io_uring_sqe * const psqe = &ps->sqes[idx];
+        ps->iov[chunk].iov_base = ps->chunks[chunk];
+        ps->iov[chunk].iov_len = len;
+        ps->offs[chunk] = ps->offset;
+        memset(psqe, 0, sizeof(*psqe));
+        psqe->opcode = IORING_OP_WRITEV;
+        psqe->fd = ps->fd;
+        psqe->addr = (unsigned long)&ps->iov[chunk];
+        psqe->len = 1;
+        psqe->off = ps->offset;
+        psqe->user_data = chunk;
+        ps->sq_array[idx] = idx;
+        __atomic_store_n(ps->sq_tail, tail + 1, __ATOMIC_RELEASE);
+        do {
+            res = syscall(__NR_io_uring_enter, ps->ring, 1, 0, 0, NULL, 0);
+        } while (res < 0 && errno == EINTR);
+        if (res != 1) {     /* The entry is not consumed by the kernel, so it is taken back with the chunk. */
+            __atomic_store_n(ps->sq_tail, tail, __ATOMIC_RELEASE);
+            if (ps->err == 0) {
+                ps->err = res < 0 ? errno : EIO;
+            }
+            ps->frees[ps->nfree++] = chunk;
+            ps->cur = -1;
+            ps->fill = 0;
+            return;
+        }
+    } else {
+        pthread_mutex_lock(&ps->lock);
+        ps->queue[(ps->qhead + ps->qcount) % SINK_DEPTH].chunk = chunk;
+        ps->queue[(ps->qhead + ps->qcount) % SINK_DEPTH].off = ps->offset;
+        ps->queue[(ps->qhead + ps->qcount) % SINK_DEPTH].len = len;
+        ++(ps->qcount);
+        pthread_cond_signal(&ps->work);
+        pthread_mutex_unlock(&ps->lock);
+    }
+
+    ps->offset += len;
+    ps->cur = -1;
+    ps->fill = 0;
+    ++(ps->stats.chunks);
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int sink_drain(struct sink_t * const ps) {
+
+    int     err;        /* Error of the sink. */
+
+    if (ps->backend == SINK_URING) {
+        while (ps->ring >= 0 && ps->nfree < SINK_DEPTH && uring_reap(ps, 1) == 0) {
+        }
+        err = ps->err;
+    } else if (ps->nworkers > 0) {
+        pthread_mutex_lock(&ps->lock);
+        while (ps->nfree < SINK_DEPTH) {
+            pthread_cond_wait(&ps->done, &ps->lock);
+        }
+        err = ps->err;
+        pthread_mutex_unlock(&ps->lock);
+    } else {
+        err = ps->err;
+    }
+
+    return err;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int uring_setup(struct sink_t * const ps) {
+
+    struct io_uring_params  p;      /* Parameters of the io_uring instance. */
+    long    ring;                   /* File descriptor of the io_uring instance. */
+
+    memset(&p, 0, sizeof(p));
+    ring = syscall(__NR_io_uring_setup, SINK_DEPTH, &p);
+    if (ring < 0) {
+        return -1;
+    }
+    ps->ring = (int)ring;
+
+    ps->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+    ps->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ps->sq_size = ps->sq_size > ps->cq_size ? ps->sq_size : ps->cq_size;
+        ps->cq_size = 0;
+    }
+    ps->sq_ptr = mmap(NULL, ps->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ps->ring,
+        IORING_OFF_SQ_RING);
+    if (ps->sq_ptr == MAP_FAILED) {
+        ps->sq_ptr = NULL;
+        uring_free(ps);
+        return -1;
+    }
+    ps->cq_ptr = ps->sq_ptr;
+    if (ps->cq_size > 0) {
+        ps->cq_ptr = mmap(NULL, ps->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ps->ring,
+            IORING_OFF_CQ_RING);
+        if (ps->cq_ptr == MAP_FAILED) {
+            ps->cq_ptr = NULL;
+            uring_free(ps);
+            return -1;
+        }
+    }
+    ps->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ps->sqes = mmap(NULL, ps->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ps->ring,
+        IORING_OFF_SQES);
+    if (ps->sqes == MAP_FAILED) {
+        ps->sqes = NULL;
+        uring_free(ps);
+        return -1;
+    }
+
+    ps->sq_tail = (unsigned int *)((char *)ps->sq_ptr + p.sq_off.tail);
+    ps->sq_mask = (unsigned int *)((char *)ps->sq_ptr + p.sq_off.ring_mask);
+    ps->sq_array = (unsigned int *)((char *)ps->sq_ptr + p.sq_off.array);
+    ps->cq_head = (unsigned int *)((char *)ps->cq_ptr + p.cq_off.head);
+    ps->cq_tail = (unsigned int *)((char *)ps->cq_ptr + p.cq_off.tail);
+    ps->cq_mask = (unsigned int *)((char *)ps->cq_ptr + p.cq_off.ring_mask);
+    ps->cqes = (struct io_uring_cqe *)((char *)ps->cq_ptr + p.cq_off.cqes);
+
+    return 0;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int uring_reap(struct sink_t * const ps, const int wait) {
+
+    unsigned int head;      /* Head of the completion queue. */
+    long    res = 0;        /* Result of the wait. */
+
+    if (wait) {
+        do {
+            res = syscall(__NR_io_uring_enter, ps->ring, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        } while (res < 0 && errno == EINTR);
+        if (res < 0 && ps->err == 0) {
+            ps->err = errno;
+        }
+    }
+
+    head = *ps->cq_head;
+    while (head != __atomic_load_n(ps->cq_tail, __ATOMIC_ACQUIRE)) {
+        const struct io_uring_cqe * const pcqe = &ps->cqes[head & *ps->cq_mask];
+        const int chunk = (int)pcqe->user_data;
+        if (pcqe->res < 0) {
+            if (ps->err == 0) {
+                ps->err = -pcqe->res;
+            }
+        } else if ((size_t)pcqe->res < ps->iov[chunk].iov_len) {    /* Short write, complete it synchronously. */
+            if (sink_pwrite(ps, ps->chunks[chunk], ps->iov[chunk].iov_len, ps->offs[chunk]) != 0 &&
+                    ps->err == 0) {
+                ps->err = errno;
+            }
+        }
+        ps->frees[ps->nfree++] = chunk;
+        ++head;
+    }
+    __atomic_store_n(ps->cq_head, head, __ATOMIC_RELEASE);
+
+    return res < 0 ? -1 : 0;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void uring_free(struct sink_t * const ps) {
+
+    if (ps->sqes != NULL) {
+        munmap(ps->sqes, ps->sqes_size);
+    }
+    if (ps->cq_ptr != NULL && ps->cq_ptr != ps->sq_ptr) {
+        munmap(ps->cq_ptr, ps->cq_size);
+    }
+    if (ps->sq_ptr != NULL) {
+        munmap(ps->sq_ptr, ps->sq_size);
+    }
+    if (ps->ring >= 0) {
+        close(ps->ring);
+    }
+    ps->sqes = NULL;
+    ps->cq_ptr = NULL;
+    ps->sq_ptr = NULL;
+    ps->ring = -1;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int threads_setup(struct sink_t * const ps) {
+
+    int     err;        /* Status of a thread creation. */
+
+    pthread_mutex_init(&ps->lock, NULL);
+    pthread_cond_init(&ps->work, NULL);
+    pthread_cond_init(&ps->done, NULL);
+
+    for (ps->nworkers = 0; ps->nworkers < SINK_WORKERS; ++(ps->nworkers)) {
+        err = pthread_create(&ps->workers[ps->nworkers], NULL, threads_worker, ps);
+        if (err != 0) {
+            break;
+        }
+    }
+    if (ps->nworkers == 0) {
+        pthread_mutex_destroy(&ps->lock);
+        pthread_cond_destroy(&ps->work);
+        pthread_cond_destroy(&ps->done);
+        errno = err;
+        return -1;
+    }
+
+    return 0;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void * threads_worker(void * const arg) {
+
+    struct sink_t * const ps = arg;
+
+    pthread_mutex_lock(&ps->lock);
+    while (1) {
+        struct sink_req_t req;
+        int     res;
+        while (ps->qcount == 0 && ps->stop == 0) {
+            pthread_cond_wait(&ps->work, &ps->lock);
+        }
+        if (ps->qcount == 0) {
+            break;
+        }
+        req = ps->queue[ps->qhead];
+        ps->qhead = (ps->qhead + 1) % SINK_DEPTH;
+        --(ps->qcount);
+        pthread_mutex_unlock(&ps->lock);
+
+        res = sink_pwrite(ps, ps->chunks[req.chunk], req.len, req.off);
+
+        pthread_mutex_lock(&ps->lock);
+        if (res != 0 && ps->err == 0) {
+            ps->err = errno;
+        }
+        ps->frees[ps->nfree++] = req.chunk;
+        pthread_cond_broadcast(&ps->done);
+    }
+    pthread_mutex_unlock(&ps->lock);
+
+    return NULL;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
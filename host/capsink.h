@@ -0,0 +1,97 @@
+/**@file
+ * @brief   Interface to the asynchronous capture sink.
+ * @details This file provides declarations for the set of functions used to write the captured generator output into
+ *  a file without blocking the producer on the disk.
+ * @details The sink accepts data of arbitrary size and collects it into aligned chunks taken from a fixed pool. Full
+ *  chunks are written into the file asynchronously at increasing offsets, and several writes are kept in flight. A
+ *  chunk returns into the pool as soon as its write completes; the producer has to wait only when all chunks of the
+ *  pool are in flight - i.e., when the disk is slower than the producer on average.
+ * @details The following backends are supported:
+ *  - SINK_SYNC     -- data is written with plain write() calls as soon as it is passed to the sink; no chunks.
+ *  - SINK_URING    -- chunks are written with Linux io_uring, the file is opened with O_DIRECT if the file system
+ *                     supports it.
+ *  - SINK_THREADS  -- chunks are written with pwrite() by a pool of writer threads; the same O_DIRECT policy.
+ *
+ * @details When SINK_URING is requested but io_uring is unavailable (an old kernel, or the system call is blocked),
+ *  the sink falls back to SINK_THREADS.
+ * @note    This module is intended for the host platform only. It requires Linux, POSIX threads and the GCC atomic
+ *  builtins.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef CAPSINK_H
+#define CAPSINK_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Backends of the capture sink.
+ * @{
+ */
+#define SINK_SYNC       (0)     /**< Synchronous write() calls. */
+#define SINK_URING      (1)     /**< Asynchronous writes with io_uring. */
+#define SINK_THREADS    (2)     /**< Asynchronous writes with a pool of writer threads. */
+/**@}*/
+
+/**@name    Parameters of the chunk pool.
+ * @{
+ */
+#define SINK_CHUNK      (1uL << 20)     /**< Size of a chunk, in bytes; multiple of the O_DIRECT alignment. */
+#define SINK_DEPTH      (8)             /**< Number of chunks in the pool, which is the maximum number of writes in
+                                         *   flight. */
+#define SINK_ALIGN      (4096)          /**< Alignment of chunks in memory and in the file. */
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for the statistics of a capture sink.
+ */
+struct sink_stats_t {
+    int     backend;            /**< Backend actually used, one of SINK_xxx. */
+    int     direct;             /**< Equals to 1 if the file is opened with O_DIRECT; 0 otherwise. */
+    unsigned long   chunks;     /**< Number of chunks written. */
+    unsigned long   waits;      /**< Number of times the producer waited for a free chunk. */
+    double  wait;               /**< Time spent by the producer waiting for free chunks, in seconds. */
+};
+
+/**@brief   Opaque data structure for a capture sink.
+ */
+struct sink_t;
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a capture sink.
+ * @{
+ */
+/**@brief   Creates a capture sink writing into a new file.
+ * @param[in]   path    -- path to the file; the file is created or truncated.
+ * @param[in]   backend -- requested backend, one of SINK_xxx.
+ * @return  Pointer to the new sink, or NULL if the file cannot be created; errno keeps the reason.
+ */
+extern struct sink_t * sink_open(const char * const path, const int backend);
+
+/**@brief   Passes data to a capture sink.
+ * @param[in,out]   ps      -- pointer to a sink.
+ * @param[in]       pdata   -- pointer to the data.
+ * @param[in]       size    -- size of the data, in bytes.
+ * @return  The status: 0 if the data is accepted, non-zero if one of previous writes has failed; errno keeps the
+ *  reason of the failure.
+ * @details The data is copied into the sink, so the buffer may be reused as soon as this function returns.
+ */
+extern int sink_write(struct sink_t * const ps, const void * const pdata, const size_t size);
+
+/**@brief   Completes all writes and closes a capture sink.
+ * @param[in,out]   ps      -- pointer to a sink; the sink is destroyed.
+ * @param[out]      pstats  -- pointer to the structure receiving the sink statistics; may be NULL.
+ * @return  The status: 0 if all the data was written, non-zero if there was a failure; errno keeps the reason.
+ * @details The last incomplete chunk is padded up to the alignment for writing, and then the file is truncated to the
+ *  total size of the data passed to the sink.
+ */
+extern int sink_close(struct sink_t * const ps, struct sink_stats_t * const pstats);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* CAPSINK_H */
@@ -0,0 +1,107 @@
+/**@file
+ * @brief   Implementation of the lock-free parameter mailbox of a generator bank.
+ * @details This file implements the set of functions used to pass new attributes of generators from a control thread
+ *  to the thread rendering a bank.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "genmail.h"
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define MAIL_NEW    (4u)                    /**< Flag of the middle copy not taken by the render thread yet. */
+#define MAIL_IDX    (3u)                    /**< Bit mask for the index of the middle copy. */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Initializes a parameter mailbox. */
+void mail_init(struct mail_t * const pm) {
+
+    struct gen_descr_t  gen;    /* Generator giving the initial attributes. */
+    ui8_t   chan;               /* Index of a channel. */
+
+    assert(pm != NULL);
+
+    memset(pm, 0, sizeof(*pm));
+    gen_init(&gen);
+    for (chan = 0; chan < BANK_MAX_CHANS; ++chan) {
+        pm->draft.prms[chan].freq = gen.freq;
+        pm->draft.prms[chan].phi = gen.phi;
+        pm->draft.prms[chan].att = gen.att;
+        pm->draft.prms[chan].en = gen.en;
+    }
+    pm->back = 0;
+    pm->front = 1;
+    pm->mid = 2;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Changes the attributes of a channel in the draft. */
+void mail_set(struct mail_t * const pm, const ui8_t chan, const struct gen_params_t * const pprm) {
+
+    assert(pm != NULL);
+    assert(chan < BANK_MAX_CHANS);
+    assert(pprm != NULL);
+
+    pm->draft.prms[chan] = *pprm;
+    ++(pm->draft.vers[chan]);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Marks all channels of the draft as changed, keeping their attributes. */
+void mail_touch(struct mail_t * const pm) {
+
+    ui8_t   chan;       /* Index of a channel. */
+
+    assert(pm != NULL);
+
+    for (chan = 0; chan < BANK_MAX_CHANS; ++chan) {
+        ++(pm->draft.vers[chan]);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Publishes the draft. */
+void mail_post(struct mail_t * const pm) {
+
+    assert(pm != NULL);
+
+    pm->sets[pm->back] = pm->draft;
+    /* The release half publishes the copy; the acquire half makes the copy given back free of reads of the render
+     * thread, which took it before it gave it away. */
+    pm->back = __atomic_exchange_n(&pm->mid, pm->back | MAIL_NEW, __ATOMIC_ACQ_REL) & MAIL_IDX;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Applies the latest published parameter set to a bank. */
+ui8_t mail_take(struct mail_t * const pm, struct bank_descr_t * const pbank) {
+
+    const struct mail_set_t * pset;     /* Parameter set taken. */
+    ui8_t   chan, cnt = 0;
+
+    assert(pm != NULL);
+    assert(pbank != NULL);
+
+    if ((__atomic_load_n(&pm->mid, __ATOMIC_ACQUIRE) & MAIL_NEW) == 0) {
+        return 0;
+    }
+    pm->front = __atomic_exchange_n(&pm->mid, pm->front, __ATOMIC_ACQ_REL) & MAIL_IDX;
+
+    pset = &pm->sets[pm->front];
+    for (chan = 0; chan < pbank->chans; ++chan) {
+        if (pset->vers[chan] != pm->vers[chan]) {
+            gen_set_params(&pbank->pgens[chan], &pset->prms[chan]);
+            pm->vers[chan] = pset->vers[chan];
+            ++cnt;
+        }
+    }
+
+    return cnt;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
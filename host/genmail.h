@@ -0,0 +1,92 @@
+/**@file
+ * @brief   Interface to the lock-free parameter mailbox of a generator bank.
+ * @details This file provides declarations for the set of functions used to pass new attributes of generators from a
+ *  control thread to the thread rendering a bank, and declaration of the mailbox data structure.
+ * @details The control thread collects changes of any channels in its own draft with \c mail_set, and publishes them
+ *  with \c mail_post as a single parameter set. The render thread calls \c mail_take at block boundaries; it applies
+ *  the latest published set to the channels changed since the previous one, with a single restart of each. Neither
+ *  side ever blocks or takes a lock:
+ *  - the mailbox keeps three copies of the parameter set: one owned by each side, and one in the middle.
+ *  - \c mail_post fills the copy of the control thread and swaps it with the middle one, flagged as new, by a single
+ *      atomic exchange with release ordering.
+ *  - \c mail_take does a single load with acquire ordering when nothing is new, and swaps the middle copy with its own
+ *      otherwise.
+ *
+ * @details Each copy is the whole parameter set, so sets posted faster than they are taken are not queued: the render
+ *  thread gets the latest one, and no change of a channel is lost. For a single generator, use a bank of one channel.
+ * @note    This module is intended for the host platform only. It requires the GCC atomic builtins. There shall be one
+ *  control thread and one render thread per mailbox; several control threads shall serialize their calls.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef GENMAIL_H
+#define GENMAIL_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "genbank.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a parameter set of a bank.
+ * @details The version of a channel is incremented by every \c mail_set of the channel; the render thread restarts the
+ *  generators which versions differ from the ones it has applied.
+ */
+struct mail_set_t {
+    struct gen_params_t prms[BANK_MAX_CHANS];   /**< Attributes of generators, one per channel. */
+    unsigned long   vers[BANK_MAX_CHANS];       /**< Versions of the attributes, one per channel. */
+};
+
+/**@brief   Data structure for a parameter mailbox.
+ */
+struct mail_t {
+    struct mail_set_t   sets[3];        /**< Copies of the parameter set. */
+    struct mail_set_t   draft;          /**< Changes collected by the control thread. */
+    unsigned int    back;               /**< Index of the copy owned by the control thread. */
+    unsigned int    front;              /**< Index of the copy owned by the render thread. */
+    unsigned long   vers[BANK_MAX_CHANS];   /**< Versions applied by the render thread, one per channel. */
+    unsigned int    mid;                /**< Index of the copy in the middle, and MAIL_NEW if it is not taken yet. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a parameter mailbox.
+ * @{
+ */
+/**@brief   Initializes a parameter mailbox.
+ * @param[in,out]   pm  -- pointer to the initialized mailbox object.
+ * @details All channels of the draft get the attributes of a generator after \c gen_init, and nothing is published.
+ */
+extern void mail_init(struct mail_t * const pm);
+
+/**@brief   Changes the attributes of a channel in the draft; called by the control thread.
+ * @param[in,out]   pm      -- pointer to a mailbox object.
+ * @param[in]       chan    -- index of the channel, from 0 to BANK_MAX_CHANS-1.
+ * @param[in]       pprm    -- pointer to the new attributes of the generator.
+ * @details The channel is restarted by the render thread even if the attributes are the same as before.
+ */
+extern void mail_set(struct mail_t * const pm, const ui8_t chan, const struct gen_params_t * const pprm);
+
+/**@brief   Marks all channels of the draft as changed, keeping their attributes; called by the control thread.
+ * @param[in,out]   pm  -- pointer to a mailbox object.
+ * @details This is used when the generators are reinitialized, e.g. with \c bank_init.
+ */
+extern void mail_touch(struct mail_t * const pm);
+
+/**@brief   Publishes the draft; called by the control thread.
+ * @param[in,out]   pm  -- pointer to a mailbox object.
+ */
+extern void mail_post(struct mail_t * const pm);
+
+/**@brief   Applies the latest published parameter set to a bank; called by the render thread.
+ * @param[in,out]   pm      -- pointer to a mailbox object.
+ * @param[in,out]   pbank   -- pointer to the bank rendered.
+ * @return  The number of generators restarted.
+ * @details Each generator of the bank changed since the previous call is assigned with \c gen_set_params.
+ */
+extern ui8_t mail_take(struct mail_t * const pm, struct bank_descr_t * const pbank);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* GENMAIL_H */
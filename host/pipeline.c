@@ -0,0 +1,433 @@
+/**@file
+ * @brief   Implementation of the pipelined capture of the generator output.
+ * @details This file implements the set of functions used to capture long runs of the output of a bank of generators
+ *  into a file with rendering, conversion and writing overlapped in separate threads.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "pipeline.h"
+#include "sampfmt.h"
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+
+/* Number of attempts a stage makes on its queue before it goes to sleep until the other end changes the queue. */
+#define PIPE_SPIN   (64)
+
+/* Block of samples passed between stages. */
+struct pipe_block_t {
+    sq015_t *raw;       /* Planar SQ0.15 samples, one row of 'block' samples per channel. */
+    ui8_t   *conv;      /* Converted interleaved frames. */
+    ui16_t  n;          /* Number of frames in the block; 0 marks the end of the stream. */
+};
+
+/* Bounded single-producer single-consumer queue of indices of blocks. The head is modified only by the consumer, and
+ * the tail only by the producer. A stage which cannot proceed on the queue sleeps on the condition variable, and the
+ * other end signals it when it changes the queue. */
+struct pipe_queue_t {
+    unsigned int    head;               /* Number of indices taken from the queue. */
+    unsigned int    tail;               /* Number of indices put into the queue. */
+    unsigned int    waiters;            /* Number of stages sleeping on the queue. */
+    pthread_cond_t  cond;               /* Signalled when the queue is changed. */
+    ui8_t   slots[PIPE_DEPTH];          /* Indices of blocks. */
+};
+
+/* Shared context of the capture. */
+struct pipe_ctx_t {
+    struct bank_descr_t *pbank;         /* Bank of generators. */
+    ui8_t   type;                       /* Format of output samples. */
+    struct sink_t * psink;              /* Output sink. */
+    unsigned long   frames;             /* Number of frames to capture. */
+    ui16_t  block;                      /* Maximum number of frames in a block. */
+    struct pipe_block_t blocks[PIPE_DEPTH];     /* Pool of blocks. */
+    struct pipe_queue_t free;           /* Blocks returned by the writer to the renderer. */
+    struct pipe_queue_t rendered;       /* Blocks passed from the renderer to the converter. */
+    struct pipe_queue_t converted;      /* Blocks passed from the converter to the writer. */
+    pthread_mutex_t lock;               /* Protects sleeping on the queues. */
+    int     abort;                      /* Set to 1 by a stage which has failed. */
+    int     err;                        /* Value of errno at the failure. */
+    struct pipe_stats_t stats;          /* Statistics. */
+};
+
+static double pipe_now(void);
+static int pipe_push(struct pipe_queue_t * const pq, const ui8_t slot);
+static int pipe_pop(struct pipe_queue_t * const pq, ui8_t * const pslot);
+static unsigned int pipe_stamp(struct pipe_queue_t * const pq);
+static void pipe_sleep(struct pipe_ctx_t * const pctx, struct pipe_queue_t * const pq, const unsigned int stamp);
+static void pipe_wake(struct pipe_ctx_t * const pctx, struct pipe_queue_t * const pq);
+static int pipe_get(struct pipe_ctx_t * const pctx, struct pipe_queue_t * const pq, ui8_t * const pslot,
+    struct pipe_stage_t * const pst);
+static int pipe_put(struct pipe_ctx_t * const pctx, struct pipe_queue_t * const pq, const ui8_t slot,
+    struct pipe_stage_t * const pst);
+static void pipe_fail(struct pipe_ctx_t * const pctx, const int err);
+static void * pipe_render(void * const arg);
+static void * pipe_convert(void * const arg);
+static void * pipe_write(void * const arg);
+
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Captures the output of a bank of generators into a file. */
+int pipe_capture(struct bank_descr_t * const pbank, const ui8_t type, struct sink_t * const psink,
+    const unsigned long frames, const ui16_t block, struct pipe_stats_t * const pstats) {
+
+    struct pipe_ctx_t * pctx;       /* Shared context of the capture. */
+    pthread_t   thr[3];             /* Threads of the stages. */
+    int     cnt;                    /* Number of threads started. */
+    int     idx;                    /* Index of a block or a thread. */
+    int     err;                    /* Status of the capture. */
+    double  start;                  /* Time of the capture start. */
+
+    assert(pbank != NULL);
+    assert(block > 0);
+
+    pctx = calloc(1, sizeof(*pctx));
+    if (pctx == NULL) {
+        return -1;
+    }
+    pctx->pbank = pbank;
+    pctx->type = type;
+    pctx->psink = psink;
+    pctx->frames = frames;
+    pctx->block = block;
+    pthread_mutex_init(&pctx->lock, NULL);
+    pthread_cond_init(&pctx->free.cond, NULL);
+    pthread_cond_init(&pctx->rendered.cond, NULL);
+    pthread_cond_init(&pctx->converted.cond, NULL);
+
+    err = 0;
+    for (idx = 0; idx < PIPE_DEPTH; ++idx) {
+        struct pipe_block_t * const pblk = &pctx->blocks[idx];
+        pblk->raw = malloc((size_t)pbank->chans * block * sizeof(sq015_t));
+        pblk->conv = malloc((size_t)pbank->chans * block * fmt_size(type));
+        if (pblk->raw == NULL || pblk->conv == NULL) {
+            err = errno;
+        }
+        pipe_push(&pctx->free, (ui8_t)idx);
+    }
+
+    start = pipe_now();
+    cnt = 0;
+    if (err == 0) {
+        static void * (* const stage[])(void *) = { pipe_render, pipe_convert, pipe_write };
+        for (cnt = 0; cnt < 3; ++cnt) {
+            err = pthread_create(&thr[cnt], NULL, stage[cnt], pctx);
+            if (err != 0) {
+                pipe_fail(pctx, err);
+                break;
+            }
+        }
+    }
+    for (idx = 0; idx < cnt; ++idx) {
+        pthread_join(thr[idx], NULL);
+    }
+    pctx->stats.elapsed = pipe_now() - start;
+
+    if (err == 0) {
+        err = pctx->err;
+    }
+    if (pstats != NULL) {
+        *pstats = pctx->stats;
+    }
+    for (idx = 0; idx < PIPE_DEPTH; ++idx) {
+        free(pctx->blocks[idx].raw);
+        free(pctx->blocks[idx].conv);
+    }
+    pthread_cond_destroy(&pctx->free.cond);
+    pthread_cond_destroy(&pctx->rendered.cond);
+    pthread_cond_destroy(&pctx->converted.cond);
+    pthread_mutex_destroy(&pctx->lock);
+    free(pctx);
+
+    if (err != 0) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+double pipe_now(void) {
+
+    struct timespec ts;     /* Current time of the monotonic clock. */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int pipe_push(struct pipe_queue_t * const pq, const ui8_t slot) {
+
+    unsigned int tail = __atomic_load_n(&pq->tail, __ATOMIC_RELAXED);      /* Own index, no ordering needed. */
+
+    if (tail - __atomic_load_n(&pq->head, __ATOMIC_ACQUIRE) == PIPE_DEPTH) {
+        return 0;
+    }
+    pq->slots[tail % PIPE_DEPTH] = slot;
+    __atomic_store_n(&pq->tail, tail + 1, __ATOMIC_RELEASE);
+
+    return 1;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int pipe_pop(struct pipe_queue_t * const pq, ui8_t * const pslot) {
+
+    unsigned int head = __atomic_load_n(&pq->head, __ATOMIC_RELAXED);      /* Own index, no ordering needed. */
+
+    if (head == __atomic_load_n(&pq->tail, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    *pslot = pq->slots[head % PIPE_DEPTH];
+    __atomic_store_n(&pq->head, head + 1, __ATOMIC_RELEASE);
+
+    return 1;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+unsigned int pipe_stamp(struct pipe_queue_t * const pq) {
+
+    /* Both indices only grow, so their sum changes whenever either end changes the queue. */
+    return __atomic_load_n(&pq->head, __ATOMIC_ACQUIRE) + __atomic_load_n(&pq->tail, __ATOMIC_ACQUIRE);
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void pipe_sleep(struct pipe_ctx_t * const pctx, struct pipe_queue_t * const pq, const unsigned int stamp) {
+
+    pthread_mutex_lock(&pctx->lock);
+    __atomic_add_fetch(&pq->waiters, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);        /* Pairs with the fence in pipe_wake. */
+    while (pipe_stamp(pq) == stamp && __atomic_load_n(&pctx->abort, __ATOMIC_ACQUIRE) == 0) {
+        pthread_cond_wait(&pq->cond, &pctx->lock);
+    }
+    __atomic_sub_fetch(&pq->waiters, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pctx->lock);
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void pipe_wake(struct pipe_ctx_t * const pctx, struct pipe_queue_t * const pq) {
+
+    /* Either the sleeper sees the change of the queue before it sleeps, or this sees the sleeper and signals it under
+     * the lock, so the signal cannot be lost. The lock is not taken while nobody sleeps. */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pq->waiters, __ATOMIC_RELAXED) != 0) {
+        pthread_mutex_lock(&pctx->lock);
+        pthread_cond_signal(&pq->cond);
+        pthread_mutex_unlock(&pctx->lock);
+    }
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int pipe_get(struct pipe_ctx_t * const pctx, struct pipe_queue_t * const pq, ui8_t * const pslot,
+    struct pipe_stage_t * const pst) {
+
+    double  start;      /* Time when the stall began. */
+    int     spin;       /* Number of failed attempts. */
+
+    if (pipe_pop(pq, pslot)) {
+        pipe_wake(pctx, pq);
+        return 1;
+    }
+    start = pipe_now();
+    ++(pst->stalls);
+    spin = 0;
+    for (;;) {
+        const unsigned int stamp = pipe_stamp(pq);
+        if (pipe_pop(pq, pslot)) {
+            break;
+        }
+        if (__atomic_load_n(&pctx->abort, __ATOMIC_ACQUIRE)) {
+            return 0;
+        }
+        if (++spin >= PIPE_SPIN) {
+            pipe_sleep(pctx, pq, stamp);
+        }
+    }
+    pipe_wake(pctx, pq);
+    pst->stall_in += pipe_now() - start;
+
+    return 1;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+int pipe_put(struct pipe_ctx_t * const pctx, struct pipe_queue_t * const pq, const ui8_t slot,
+    struct pipe_stage_t * const pst) {
+
+    double  start;      /* Time when the stall began. */
+    int     spin;       /* Number of failed attempts. */
+
+    if (pipe_push(pq, slot)) {
+        pipe_wake(pctx, pq);
+        return 1;
+    }
+    start = pipe_now();
+    ++(pst->stalls);
+    spin = 0;
+    for (;;) {
+        const unsigned int stamp = pipe_stamp(pq);
+        if (pipe_push(pq, slot)) {
+            break;
+        }
+        if (__atomic_load_n(&pctx->abort, __ATOMIC_ACQUIRE)) {
+            return 0;
+        }
+        if (++spin >= PIPE_SPIN) {
+            pipe_sleep(pctx, pq, stamp);
+        }
+    }
+    pipe_wake(pctx, pq);
+    pst->stall_out += pipe_now() - start;
+
+    return 1;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void pipe_fail(struct pipe_ctx_t * const pctx, const int err) {
+
+    if (__atomic_exchange_n(&pctx->abort, 1, __ATOMIC_ACQ_REL) == 0) {
+        pctx->err = err;
+    }
+    pthread_mutex_lock(&pctx->lock);
+    pthread_cond_broadcast(&pctx->free.cond);
+    pthread_cond_broadcast(&pctx->rendered.cond);
+    pthread_cond_broadcast(&pctx->converted.cond);
+    pthread_mutex_unlock(&pctx->lock);
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void * pipe_render(void * const arg) {
+
+    struct pipe_ctx_t * const pctx = arg;
+    struct pipe_stage_t * const pst = &pctx->stats.render;
+    unsigned long   left = pctx->frames;    /* Number of frames not yet rendered. */
+    ui8_t   slot;                           /* Index of the current block. */
+
+    do {
+        struct pipe_block_t * pblk;
+        ui8_t   chan;
+        double  start;
+
+        if (pipe_get(pctx, &pctx->free, &slot, pst) == 0) {
+            break;
+        }
+        start = pipe_now();
+        pblk = &pctx->blocks[slot];
+        pblk->n = left < pctx->block ? (ui16_t)left : pctx->block;
+        for (chan = 0; chan < pctx->pbank->chans; ++chan) {
+            gen_render(&pctx->pbank->pgens[chan], pblk->raw + (size_t)chan * pctx->block, pblk->n);
+        }
+        left -= pblk->n;
+        pst->busy += pipe_now() - start;
+        pst->blocks += pblk->n > 0;
+        if (pipe_put(pctx, &pctx->rendered, slot, pst) == 0) {
+            break;
+        }
+    } while (pctx->blocks[slot].n > 0);
+
+    return NULL;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void * pipe_convert(void * const arg) {
+
+    struct pipe_ctx_t * const pctx = arg;
+    struct pipe_stage_t * const pst = &pctx->stats.convert;
+    struct fmt_descr_t  fmt;                /* Format of the output frames. */
+    ui8_t   slot;                           /* Index of the current block. */
+
+    fmt.type = pctx->type;
+    fmt.chans = pctx->pbank->chans;
+
+    do {
+        struct pipe_block_t * pblk;
+        double  start;
+
+        if (pipe_get(pctx, &pctx->rendered, &slot, pst) == 0) {
+            break;
+        }
+        start = pipe_now();
+        pblk = &pctx->blocks[slot];
+        for (fmt.chan = 0; fmt.chan < fmt.chans; ++fmt.chan) {
+            fmt_convert(&fmt, pblk->raw + (size_t)fmt.chan * pctx->block, pblk->conv, pblk->n);
+        }
+        pst->busy += pipe_now() - start;
+        pst->blocks += pblk->n > 0;
+        if (pipe_put(pctx, &pctx->converted, slot, pst) == 0) {
+            break;
+        }
+    } while (pctx->blocks[slot].n > 0);
+
+    return NULL;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void * pipe_write(void * const arg) {
+
+    struct pipe_ctx_t * const pctx = arg;
+    struct pipe_stage_t * const pst = &pctx->stats.write;
+    size_t  frame;                          /* Size of a frame, in bytes. */
+    ui8_t   slot;                           /* Index of the current block. */
+
+    frame = (size_t)fmt_size(pctx->type) * pctx->pbank->chans;
+
+    while (pipe_get(pctx, &pctx->converted, &slot, pst)) {
+        struct pipe_block_t * const pblk = &pctx->blocks[slot];
+        double  start;
+
+        if (pblk->n == 0) {
+            break;
+        }
+        start = pipe_now();
+        if (sink_write(pctx->psink, pblk->conv, pblk->n * frame) != 0) {
+            pipe_fail(pctx, errno);
+            return NULL;
+        }
+        pctx->stats.frames += pblk->n;
+        pst->busy += pipe_now() - start;
+        ++(pst->blocks);
+        if (pipe_put(pctx, &pctx->free, slot, pst) == 0) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,75 @@
+/**@file
+ * @brief   Interface to the pipelined capture of the generator output.
+ * @details This file provides declarations for the set of functions used to capture long runs of the output of a bank
+ *  of generators into a file, and declarations of data structures for the capture statistics.
+ * @details The capture is split into three stages running in separate threads:
+ *  - render    -- the generators of the bank render planar blocks of SQ0.15 samples, one row per channel.
+ *  - convert   -- rows are converted into the output sample format and interleaved into frames.
+ *  - write     -- frames are passed to the capture sink, which writes them into the output file; see \c capsink.h.
+ *
+ * @details Stages are connected with bounded lock-free single-producer single-consumer queues which pass blocks from
+ *  a fixed pool. The writer returns each block to the pool when it is written, so the amount of memory is bounded and
+ *  all three stages overlap: the throughput of the capture is set by the slowest stage.
+ * @details A stage which finds its input queue empty or its output queue full retries a few times, and then sleeps
+ *  on a condition variable until the other end of the queue changes it, so a stalled stage does not consume the CPU.
+ * @note    This module is intended for the host platform only. It requires POSIX threads and the GCC atomic builtins.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "capsink.h"
+#include "genbank.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Number of blocks in the pool, which is also the capacity of each queue between stages.
+ */
+#define PIPE_DEPTH  (8)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for statistics of a single stage of the pipeline.
+ * @details A stage stalls on input when its input queue is empty, and it stalls on output when its output queue is
+ *  full. The busy time is the time the stage spends processing blocks, excluding stalls.
+ */
+struct pipe_stage_t {
+    unsigned long   blocks;     /**< Number of blocks processed by the stage. */
+    unsigned long   stalls;     /**< Number of times the stage had to wait for its input or output queue. */
+    double  busy;               /**< Time spent processing blocks, in seconds. */
+    double  stall_in;           /**< Time spent waiting for input blocks, in seconds. */
+    double  stall_out;          /**< Time spent waiting for room in the output queue, in seconds. */
+};
+
+/**@brief   Data structure for statistics of the capture.
+ */
+struct pipe_stats_t {
+    struct pipe_stage_t render;     /**< Statistics of the render stage. */
+    struct pipe_stage_t convert;    /**< Statistics of the convert stage. */
+    struct pipe_stage_t write;      /**< Statistics of the write stage. */
+    double  elapsed;                /**< Total time of the capture, in seconds. */
+    unsigned long   frames;         /**< Number of frames written. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Captures the output of a bank of generators into a file.
+ * @param[in,out]   pbank   -- pointer to a bank descriptor object; generators shall be configured beforehand.
+ * @param[in]       type    -- format of output samples, one of FMT_xxx; see \c sampfmt.h.
+ * @param[in,out]   psink   -- pointer to the capture sink of the output file; the caller closes it afterwards.
+ * @param[in]       frames  -- number of frames to capture.
+ * @param[in]       block   -- number of frames in a block passed between stages, 1 or more.
+ * @param[out]      pstats  -- pointer to the structure receiving the capture statistics; may be NULL.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure. In case of failure errno keeps
+ *  the reason of the failure.
+ * @details The file receives the same sequence of bytes as if \c bank_render was called serially for consecutive
+ *  blocks and each block was passed to the sink.
+ */
+extern int pipe_capture(struct bank_descr_t * const pbank, const ui8_t type, struct sink_t * const psink,
+    const unsigned long frames, const ui16_t block, struct pipe_stats_t * const pstats);
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* PIPELINE_H */
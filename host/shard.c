@@ -0,0 +1,76 @@
+/**@file
+ * @brief   Implementation of the sharding of sweeps.
+ * @details This file implements the set of functions used to split a sweep into shards and to describe the result
+ *  files of the shards.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "shard.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Parses the shard given in the command line. */
+int shard_parse(const char * const str, struct shard_t * const psh) {
+
+    char *  pend;
+
+    assert(str != NULL);
+    assert(psh != NULL);
+
+    psh->k = strtoul(str, &pend, 10);
+    if (pend == str || *pend != '/') {
+        return -1;
+    }
+    psh->n = strtoul(pend + 1, &pend, 10);
+    if (*pend != '\0' || psh->n == 0 || psh->k >= psh->n) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Returns the number of items of a shard. */
+unsigned long shard_items(const struct shard_t * const psh) {
+
+    assert(psh != NULL && psh->n > 0);
+
+    return psh->total / psh->n + (psh->k < psh->total % psh->n);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Writes the header line of a result file. */
+void shard_write(FILE * const pfile, const struct shard_t * const psh) {
+
+    assert(pfile != NULL);
+    assert(psh != NULL);
+
+    fprintf(pfile, "# shard %s %lu/%lu %lu\n", psh->job, psh->k, psh->n, psh->total);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Reads the header line of a result file. */
+int shard_read(FILE * const pfile, struct shard_t * const psh) {
+
+    char    line[128];      /* Header line. */
+    char    tail;           /* Character after the header, which shall be the end of the line. */
+
+    assert(pfile != NULL);
+    assert(psh != NULL);
+
+    if (fgets(line, sizeof(line), pfile) == NULL ||
+            sscanf(line, "# shard %31s %lu/%lu %lu%c", psh->job, &psh->k, &psh->n, &psh->total, &tail) != 5 ||
+            tail != '\n' || psh->n == 0 || psh->k >= psh->n) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,78 @@
+/**@file
+ * @brief   Interface to the sharding of sweeps.
+ * @details This file provides declarations for the set of functions used to split a sweep over a catalogue of items
+ *  into shards, which run in separate processes or on separate hosts, and to combine their partial results.
+ * @details The shard k of N takes the items with indices k, k+N, k+2N and so on, so each shard gets its share of slow
+ *  and fast items wherever they are in the catalogue. A result file starts with the header line:
+ *  - # shard job k/N total
+ *
+ * @details where job is the name of the sweep, and total is the number of items of the whole catalogue. The header is
+ *  followed by comment lines starting with #, and then by one line per item of the shard, in the order of the indices.
+ *  The whole file of an unsharded sweep is the shard 0/1. Given the header, the j-th item line of a shard belongs to
+ *  the item j*N + k, so shards are merged back into the file of the unsharded sweep by interleaving their lines, see
+ *  \c shardmerge. For example, four local processes:
+ *  - for k in 0 1 2 3; do tools/golden -s $k/4 -w part$k & done; wait; tools/shardmerge -o golden.txt part*
+ *
+ * @note    This module is intended for the host platform only.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef SHARD_H
+#define SHARD_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "fixtypes.h"
+#include <stdio.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Maximum length of the name of a sweep, in characters.
+ */
+#define SHARD_JOB_LEN   (31)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a shard of a sweep.
+ */
+struct shard_t {
+    char    job[SHARD_JOB_LEN + 1];     /**< Name of the sweep. */
+    unsigned long   k;                  /**< Index of the shard, from 0 to n-1. */
+    unsigned long   n;                  /**< Number of shards. */
+    unsigned long   total;              /**< Number of items of the whole catalogue. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing the sharding of sweeps.
+ * @{
+ */
+/**@brief   Parses the shard given in the command line.
+ * @param[in]   str     -- shard in the form k/N.
+ * @param[out]  psh     -- pointer to the shard receiving k and N.
+ * @return  The status: 0 if the shard is valid, non-zero otherwise.
+ */
+extern int shard_parse(const char * const str, struct shard_t * const psh);
+
+/**@brief   Returns the number of items of a shard.
+ * @param[in]   psh     -- pointer to the shard.
+ * @return  The number of items of the catalogue which belong to the shard.
+ */
+extern unsigned long shard_items(const struct shard_t * const psh);
+
+/**@brief   Writes the header line of a result file.
+ * @param[in,out]   pfile   -- result file.
+ * @param[in]       psh     -- pointer to the shard.
+ */
+extern void shard_write(FILE * const pfile, const struct shard_t * const psh);
+
+/**@brief   Reads the header line of a result file.
+ * @param[in,out]   pfile   -- result file.
+ * @param[out]      psh     -- pointer to the shard receiving the header.
+ * @return  The status: 0 if the header is valid, non-zero otherwise.
+ */
+extern int shard_read(FILE * const pfile, struct shard_t * const psh);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* SHARD_H */
@@ -0,0 +1,406 @@
+/**@file
+ * @brief   Implementation of the shared memory output ring.
+ * @details This file implements the set of functions used to pass the rendered generator output to other local
+ *  processes through a POSIX shared memory object.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "shmring.h"
+#include "sampfmt.h"
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+
+#define RING_MAGIC      (0x474E4952uL)  /* Tag of a valid ring: "RING". */
+#define RING_VERSION    (1uL)           /* Version of the layout of the shared memory object. */
+#define RING_LINE       (64)            /* Alignment of the header, slots and frames in the object. */
+#define RING_SPINS      (64)            /* Number of yields before a waiting side starts to sleep. */
+
+/* States of a place of a reader. */
+#define RING_FREE       (0uL)           /* The place is free. */
+#define RING_JOINING    (1uL)           /* A reader is attaching at the place. */
+#define RING_ACTIVE     (2uL)           /* A reader is attached at the place. */
+
+/* Header of the shared memory object. */
+struct ring_hdr_t {
+    unsigned long   magic;                      /* RING_MAGIC when the ring is initialized. */
+    unsigned long   version;                    /* RING_VERSION. */
+    unsigned long   size;                       /* Size of the object, in bytes. */
+    unsigned long   stride;                     /* Distance between slots, in bytes. */
+    struct ring_info_t  info;                   /* Parameters of the ring. */
+    unsigned long   head;                       /* Number of blocks published. */
+    unsigned long   closed;                     /* Set to 1 when the writer has closed the ring. */
+    unsigned long   states[RING_MAX_READERS];   /* States of places of readers, RING_xxx. */
+    unsigned long   cursors[RING_MAX_READERS];  /* Number of the next block to be consumed by each reader. */
+};
+
+/* Header of a slot; frames follow it at the distance of RING_LINE. */
+struct ring_slot_t {
+    unsigned long   seq;        /* 2*b + 1 while the block b is being written, 2*b + 2 when it is published. */
+    unsigned long   n;          /* Number of frames in the block. */
+};
+
+/* End of a ring. */
+struct ring_t {
+    struct ring_hdr_t * phdr;   /* Mapping of the shared memory object. */
+    char *  name;               /* Name of the object; NULL for a reader. */
+    int     place;              /* Place of the reader; -1 for the writer. */
+    unsigned long   pos;        /* Number of the block being written or the next block to be consumed. */
+    struct ring_stats_t stats;  /* Statistics. */
+};
+
+static double ring_now(void);
+static void ring_wait(int * const pspins);
+static struct ring_slot_t * ring_slot(const struct ring_t * const pr, const unsigned long blk);
+
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Creates a ring. */
+struct ring_t * ring_create(const char * const name, const struct ring_info_t * const pinfo) {
+
+    struct ring_t * pr;         /* New writer. */
+    size_t  stride, size;       /* Distance between slots, and size of the object. */
+    int     fd, err;
+
+    assert(name != NULL);
+    assert(pinfo != NULL);
+    assert(pinfo->chans > 0);
+    assert(pinfo->block > 0);
+    assert(pinfo->slots >= 2);
+    assert(pinfo->policy == RING_BLOCK || pinfo->policy == RING_OVERWRITE);
+
+    stride = (size_t)fmt_size(pinfo->type) * pinfo->chans * pinfo->block;
+    stride = RING_LINE + (stride + RING_LINE - 1) / RING_LINE * RING_LINE;
+    size = (sizeof(struct ring_hdr_t) + RING_LINE - 1) / RING_LINE * RING_LINE + stride * pinfo->slots;
+
+    pr = calloc(1, sizeof(*pr) + strlen(name) + 1);
+    if (pr == NULL) {
+        return NULL;
+    }
+    pr->name = (char *)(pr + 1);
+    strcpy(pr->name, name);
+    pr->place = -1;
+
+    shm_unlink(name);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        free(pr);
+        return NULL;
+    }
+    if (ftruncate(fd, size) != 0) {
+        err = errno;
+        close(fd);
+        shm_unlink(name);
+        free(pr);
+        errno = err;
+        return NULL;
+    }
+    pr->phdr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    err = errno;
+    close(fd);
+    if (pr->phdr == MAP_FAILED) {
+        shm_unlink(name);
+        free(pr);
+        errno = err;
+        return NULL;
+    }
+
+    pr->phdr->version = RING_VERSION;
+    pr->phdr->size = size;
+    pr->phdr->stride = stride;
+    pr->phdr->info = *pinfo;
+    __atomic_store_n(&pr->phdr->magic, RING_MAGIC, __ATOMIC_RELEASE);
+
+    return pr;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Claims the next slot for writing. */
+void * ring_claim(struct ring_t * const pr) {
+
+    struct ring_hdr_t * const phdr = pr->phdr;
+    struct ring_slot_t * pslot;     /* Claimed slot. */
+    double  start = 0.0;            /* Time when the wait began. */
+    int     spins = 0;              /* Number of waits so far. */
+    int     place;                  /* Place of a reader. */
+
+    assert(pr != NULL);
+    assert(pr->place < 0);
+
+    if (phdr->info.policy == RING_BLOCK) {
+        for (place = 0; place < RING_MAX_READERS; ++place) {
+            while (__atomic_load_n(&phdr->states[place], __ATOMIC_ACQUIRE) == RING_ACTIVE &&
+                    pr->pos - __atomic_load_n(&phdr->cursors[place], __ATOMIC_ACQUIRE) >= phdr->info.slots) {
+                if (spins == 0) {
+                    start = ring_now();
+                    ++(pr->stats.waits);
+                }
+                ring_wait(&spins);
+            }
+        }
+        if (spins > 0) {
+            pr->stats.wait += ring_now() - start;
+        }
+    }
+
+    pslot = ring_slot(pr, pr->pos);
+    __atomic_store_n(&pslot->seq, 2 * pr->pos + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return (ui8_t *)pslot + RING_LINE;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Publishes the claimed slot to readers. */
+void ring_publish(struct ring_t * const pr, const ui16_t n) {
+
+    struct ring_slot_t * const pslot = ring_slot(pr, pr->pos);
+
+    assert(pr != NULL);
+    assert(pr->place < 0);
+    assert(n > 0 && n <= pr->phdr->info.block);
+
+    pslot->n = n;
+    __atomic_store_n(&pslot->seq, 2 * pr->pos + 2, __ATOMIC_RELEASE);
+    ++(pr->pos);
+    __atomic_store_n(&pr->phdr->head, pr->pos, __ATOMIC_RELEASE);
+    ++(pr->stats.blocks);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Closes and removes a ring. */
+void ring_destroy(struct ring_t * const pr, struct ring_stats_t * const pstats) {
+
+    assert(pr != NULL);
+    assert(pr->place < 0);
+
+    __atomic_store_n(&pr->phdr->closed, 1, __ATOMIC_RELEASE);
+    shm_unlink(pr->name);
+    munmap(pr->phdr, pr->phdr->size);
+    if (pstats != NULL) {
+        *pstats = pr->stats;
+    }
+    free(pr);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Attaches a reader to a ring. */
+struct ring_t * ring_attach(const char * const name, struct ring_info_t * const pinfo) {
+
+    struct ring_t * pr;         /* New reader. */
+    struct stat st;             /* Status of the object. */
+    int     fd, err;
+
+    assert(name != NULL);
+
+    pr = calloc(1, sizeof(*pr));
+    if (pr == NULL) {
+        return NULL;
+    }
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        free(pr);
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0) {
+        err = errno;
+    } else if (st.st_size < (off_t)sizeof(struct ring_hdr_t)) {
+        err = EINVAL;
+    } else {
+        err = 0;
+    }
+    if (err != 0) {
+        close(fd);
+        free(pr);
+        errno = err;
+        return NULL;
+    }
+    pr->phdr = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    err = errno;
+    close(fd);
+    if (pr->phdr == MAP_FAILED) {
+        free(pr);
+        errno = err;
+        return NULL;
+    }
+    if (__atomic_load_n(&pr->phdr->magic, __ATOMIC_ACQUIRE) != RING_MAGIC || pr->phdr->version != RING_VERSION ||
+            pr->phdr->size != (unsigned long)st.st_size) {
+        munmap(pr->phdr, st.st_size);
+        free(pr);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    for (pr->place = 0; pr->place < RING_MAX_READERS; ++(pr->place)) {
+        unsigned long state = RING_FREE;
+        if (__atomic_compare_exchange_n(&pr->phdr->states[pr->place], &state, RING_JOINING, 0, __ATOMIC_ACQ_REL,
+                __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    if (pr->place == RING_MAX_READERS) {
+        munmap(pr->phdr, pr->phdr->size);
+        free(pr);
+        errno = EBUSY;
+        return NULL;
+    }
+    pr->pos = __atomic_load_n(&pr->phdr->head, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&pr->phdr->cursors[pr->place], pr->pos, __ATOMIC_RELEASE);
+    __atomic_store_n(&pr->phdr->states[pr->place], RING_ACTIVE, __ATOMIC_RELEASE);
+
+    if (pinfo != NULL) {
+        *pinfo = pr->phdr->info;
+    }
+
+    return pr;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Waits for the next block and acquires it. */
+const void * ring_acquire(struct ring_t * const pr, ui16_t * const pn) {
+
+    struct ring_hdr_t * const phdr = pr->phdr;
+    double  start = 0.0;            /* Time when the wait began. */
+    int     spins = 0;              /* Number of waits so far. */
+
+    assert(pr != NULL);
+    assert(pr->place >= 0);
+    assert(pn != NULL);
+
+    while (1) {
+        const unsigned long head = __atomic_load_n(&phdr->head, __ATOMIC_ACQUIRE);
+        const struct ring_slot_t * pslot;
+
+        if (pr->pos == head) {
+            if (__atomic_load_n(&phdr->closed, __ATOMIC_ACQUIRE) && __atomic_load_n(&phdr->head, __ATOMIC_ACQUIRE) ==
+                    head) {
+                break;
+            }
+            if (spins == 0) {
+                start = ring_now();
+                ++(pr->stats.waits);
+            }
+            ring_wait(&spins);
+            continue;
+        }
+        /* Only the last blocks are still in the ring when the reader is lapped by the overwriting writer. */
+        if (head - pr->pos > phdr->info.slots) {
+            pr->stats.lost += head - phdr->info.slots - pr->pos;
+            pr->pos = head - phdr->info.slots;
+        }
+        pslot = ring_slot(pr, pr->pos);
+        if (__atomic_load_n(&pslot->seq, __ATOMIC_ACQUIRE) == 2 * pr->pos + 2) {
+            if (spins > 0) {
+                pr->stats.wait += ring_now() - start;
+            }
+            *pn = (ui16_t)pslot->n;
+            return (const ui8_t *)pslot + RING_LINE;
+        }
+        /* The slot is being filled or already holds a later block. */
+        ++(pr->stats.lost);
+        ++(pr->pos);
+    }
+
+    if (spins > 0) {
+        pr->stats.wait += ring_now() - start;
+    }
+    *pn = 0;
+
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Releases the acquired block. */
+int ring_release(struct ring_t * const pr) {
+
+    const struct ring_slot_t * const pslot = ring_slot(pr, pr->pos);
+    int     res;        /* Status of the block. */
+
+    assert(pr != NULL);
+    assert(pr->place >= 0);
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    res = __atomic_load_n(&pslot->seq, __ATOMIC_RELAXED) != 2 * pr->pos + 2;
+    if (res) {
+        ++(pr->stats.lost);
+    } else {
+        ++(pr->stats.blocks);
+    }
+    ++(pr->pos);
+    __atomic_store_n(&pr->phdr->cursors[pr->place], pr->pos, __ATOMIC_RELEASE);
+
+    return res;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Detaches a reader from a ring. */
+void ring_detach(struct ring_t * const pr, struct ring_stats_t * const pstats) {
+
+    assert(pr != NULL);
+    assert(pr->place >= 0);
+
+    __atomic_store_n(&pr->phdr->states[pr->place], RING_FREE, __ATOMIC_RELEASE);
+    munmap(pr->phdr, pr->phdr->size);
+    if (pstats != NULL) {
+        *pstats = pr->stats;
+    }
+    free(pr);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+double ring_now(void) {
+
+    struct timespec ts;     /* Current time of the monotonic clock. */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void ring_wait(int * const pspins) {
+
+    /* The other side is another process, so yield first, and then sleep to let an idle writer or reader go. */
+    if (*pspins < RING_SPINS) {
+        sched_yield();
+    } else {
+        struct timespec ts;
+        ts.tv_sec = 0;
+        ts.tv_nsec = 50000;
+        nanosleep(&ts, NULL);
+    }
+    ++(*pspins);
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+struct ring_slot_t * ring_slot(const struct ring_t * const pr, const unsigned long blk) {
+
+    return (struct ring_slot_t *)((ui8_t *)pr->phdr +
+        (sizeof(struct ring_hdr_t) + RING_LINE - 1) / RING_LINE * RING_LINE +
+        (blk % pr->phdr->info.slots) * pr->phdr->stride);
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,145 @@
+/**@file
+ * @brief   Interface to the shared memory output ring.
+ * @details This file provides declarations for the set of functions used to pass the rendered generator output to
+ *  other local processes through a POSIX shared memory object, without copies or sockets.
+ * @details The ring is a shared memory object created with shm_open by the writer - the generator process. It
+ *  contains a header and a fixed number of slots; each slot holds one block of interleaved frames in the given sample
+ *  format. The writer renders block after block directly into slots, and numbers blocks with increasing sequence
+ *  numbers. Readers map the same object, follow the sequence numbers and consume blocks in place.
+ * @details Each slot carries its own sequence counter, which is odd while the writer fills the slot and even when the
+ *  block is published. A reader checks the counter before and after it consumes a block, so it always knows whether
+ *  the block was overwritten under its feet.
+ * @details The policy of the ring defines what happens when the writer reaches a slot which is not yet consumed:
+ *  - RING_BLOCK        -- the writer waits until all attached readers consume the slot (back-pressure). A reader
+ *                         which stops consuming stops the writer, too.
+ *  - RING_OVERWRITE    -- the writer never waits; readers which lag behind by more than the whole ring lose the
+ *                         oldest blocks and are told how many blocks they have lost.
+ *
+ * @note    This module is intended for the host platform only. It requires POSIX shared memory and the GCC atomic
+ *  builtins. The writer and readers shall run on the same machine and be built for the same ABI.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef SHMRING_H
+#define SHMRING_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "fixtypes.h"
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Policies of the ring.
+ * @{
+ */
+#define RING_BLOCK      (0)     /**< The writer waits for readers. */
+#define RING_OVERWRITE  (1)     /**< The writer overwrites blocks which are not consumed. */
+/**@}*/
+
+/**@brief   Maximum number of readers attached to a ring at the same time.
+ */
+#define RING_MAX_READERS    (16)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for the parameters of a ring.
+ */
+struct ring_info_t {
+    ui8_t   type;           /**< Format of samples, one of FMT_xxx; see \c sampfmt.h. */
+    ui8_t   chans;          /**< Number of channels in a frame. */
+    ui16_t  block;          /**< Maximum number of frames in a slot. */
+    ui16_t  slots;          /**< Number of slots in the ring. */
+    ui8_t   policy;         /**< Policy of the ring, one of RING_xxx. */
+};
+
+/**@brief   Data structure for the statistics of a ring.
+ * @details The writer counts its waits for readers; a reader counts its waits for the writer, and the blocks it has
+ *  lost because they were overwritten.
+ */
+struct ring_stats_t {
+    unsigned long   blocks;     /**< Number of blocks published or consumed. */
+    unsigned long   lost;       /**< Number of blocks lost by a reader; always 0 for the writer. */
+    unsigned long   waits;      /**< Number of times the writer or reader had to wait. */
+    double  wait;               /**< Time spent waiting, in seconds. */
+};
+
+/**@brief   Opaque data structure for an end of a ring: either the writer or a reader.
+ */
+struct ring_t;
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to the writer of a ring.
+ * @{
+ */
+/**@brief   Creates a ring.
+ * @param[in]   name    -- name of the shared memory object, starting with a slash, e.g. "/tone".
+ * @param[in]   pinfo   -- pointer to the parameters of the ring; \c slots shall be 2 or more.
+ * @return  Pointer to the writer of the ring, or NULL if the ring cannot be created; errno keeps the reason.
+ * @details An existing object with the same name is replaced.
+ */
+extern struct ring_t * ring_create(const char * const name, const struct ring_info_t * const pinfo);
+
+/**@brief   Claims the next slot for writing.
+ * @param[in,out]   pr  -- pointer to the writer of a ring.
+ * @return  Pointer to the first frame of the slot, where up to \c block frames may be stored.
+ * @details With the RING_BLOCK policy this function waits until all attached readers consume the block stored in the
+ *  slot before.
+ */
+extern void * ring_claim(struct ring_t * const pr);
+
+/**@brief   Publishes the claimed slot to readers.
+ * @param[in,out]   pr  -- pointer to the writer of a ring.
+ * @param[in]       n   -- number of frames stored into the slot, from 1 to \c block.
+ */
+extern void ring_publish(struct ring_t * const pr, const ui16_t n);
+
+/**@brief   Closes and removes a ring.
+ * @param[in,out]   pr      -- pointer to the writer of a ring; the writer is destroyed.
+ * @param[out]      pstats  -- pointer to the structure receiving the writer statistics; may be NULL.
+ * @details Readers which are attached to the ring consume the remaining blocks, and then they are told the ring is
+ *  closed. The name of the object is removed at once, so new readers cannot attach.
+ */
+extern void ring_destroy(struct ring_t * const pr, struct ring_stats_t * const pstats);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a reader of a ring.
+ * @{
+ */
+/**@brief   Attaches a reader to a ring.
+ * @param[in]   name    -- name of the shared memory object.
+ * @param[out]  pinfo   -- pointer to the structure receiving the parameters of the ring; may be NULL.
+ * @return  Pointer to the reader, or NULL if the ring cannot be opened or all places of readers are taken; errno keeps
+ *  the reason.
+ * @details The reader starts with the next block published by the writer.
+ */
+extern struct ring_t * ring_attach(const char * const name, struct ring_info_t * const pinfo);
+
+/**@brief   Waits for the next block and acquires it.
+ * @param[in,out]   pr  -- pointer to a reader.
+ * @param[out]      pn  -- pointer to the variable receiving the number of frames in the block.
+ * @return  Pointer to the first frame of the block in the ring, or NULL if the ring is closed and there are no more
+ *  blocks.
+ * @details The block stays valid until \c ring_release is called. With the RING_OVERWRITE policy the writer may
+ *  overwrite the block while it is consumed; \c ring_release tells whether that happened.
+ */
+extern const void * ring_acquire(struct ring_t * const pr, ui16_t * const pn);
+
+/**@brief   Releases the acquired block.
+ * @param[in,out]   pr  -- pointer to a reader.
+ * @return  The status: 0 if the block was consumed intact, non-zero if it was overwritten during consumption and the
+ *  consumed data shall be discarded.
+ */
+extern int ring_release(struct ring_t * const pr);
+
+/**@brief   Detaches a reader from a ring.
+ * @param[in,out]   pr      -- pointer to a reader; the reader is destroyed.
+ * @param[out]      pstats  -- pointer to the structure receiving the reader statistics; may be NULL.
+ */
+extern void ring_detach(struct ring_t * const pr, struct ring_stats_t * const pstats);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* SHMRING_H */
@@ -0,0 +1,119 @@
+/**@file
+ * @brief   Implementation of the protocol of the tone server.
+ * @details This file implements the set of functions used to encode, send and receive messages of the protocol spoken
+ *  between the tone server and its clients.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "toneproto.h"
+#include <assert.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Encodes the header of a message. */
+void tone_pack(const struct tone_msg_t * const pmsg, ui8_t * const pbuf) {
+
+    assert(pmsg != NULL);
+    assert(pbuf != NULL);
+
+    pbuf[0] = pmsg->cmd;
+    pbuf[1] = pmsg->arg;
+    pbuf[2] = (ui8_t)pmsg->a;
+    pbuf[3] = (ui8_t)(pmsg->a >> 8);
+    pbuf[4] = (ui8_t)pmsg->b;
+    pbuf[5] = (ui8_t)(pmsg->b >> 8);
+    pbuf[6] = (ui8_t)pmsg->c;
+    pbuf[7] = (ui8_t)(pmsg->c >> 8);
+    pbuf[8] = (ui8_t)pmsg->d;
+    pbuf[9] = (ui8_t)(pmsg->d >> 8);
+    pbuf[10] = (ui8_t)(pmsg->d >> 16);
+    pbuf[11] = (ui8_t)(pmsg->d >> 24);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Decodes the header of a message. */
+void tone_unpack(const ui8_t * const pbuf, struct tone_msg_t * const pmsg) {
+
+    assert(pbuf != NULL);
+    assert(pmsg != NULL);
+
+    pmsg->cmd = pbuf[0];
+    pmsg->arg = pbuf[1];
+    pmsg->a = (ui16_t)(pbuf[2] | (pbuf[3] << 8));
+    pmsg->b = (ui16_t)(pbuf[4] | (pbuf[5] << 8));
+    pmsg->c = (ui16_t)(pbuf[6] | (pbuf[7] << 8));
+    pmsg->d = pbuf[8] | ((unsigned long)pbuf[9] << 8) | ((unsigned long)pbuf[10] << 16) |
+        ((unsigned long)pbuf[11] << 24);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Sends a message. */
+int tone_send(const int fd, const struct tone_msg_t * const pmsg, const void * const pdata, const size_t size) {
+
+    ui8_t   hdr[TONE_MSG_SIZE];     /* Encoded header. */
+    struct iovec    iov[2];         /* Parts of the message not yet sent. */
+    int     cnt = size > 0 ? 2 : 1; /* Number of parts. */
+    int     idx = 0;                /* Index of the first part not yet sent. */
+
+    assert(pmsg != NULL);
+    assert(pdata != NULL || size == 0);
+
+    tone_pack(pmsg, hdr);
+    iov[0].iov_base = hdr;
+    iov[0].iov_len = TONE_MSG_SIZE;
+    iov[1].iov_base = (void *)pdata;
+    iov[1].iov_len = size;
+
+    while (idx < cnt) {
+        ssize_t res = writev(fd, &iov[idx], cnt - idx);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        while (idx < cnt && (size_t)res >= iov[idx].iov_len) {
+            res -= iov[idx].iov_len;
+            ++idx;
+        }
+        if (idx < cnt) {
+            iov[idx].iov_base = (ui8_t *)iov[idx].iov_base + res;
+            iov[idx].iov_len -= res;
+        }
+    }
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Receives exactly the given number of bytes. */
+int tone_recv(const int fd, void * const pbuf, const size_t size) {
+
+    size_t  done = 0;       /* Number of bytes received. */
+
+    assert(pbuf != NULL || size == 0);
+
+    while (done < size) {
+        ssize_t res = read(fd, (ui8_t *)pbuf + done, size - done);
+        if (res < 0 && errno == EINTR) {
+            continue;
+        }
+        if (res <= 0) {
+            return -1;
+        }
+        done += res;
+    }
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,133 @@
+/**@file
+ * @brief   Interface to the protocol of the tone server.
+ * @details This file provides declarations for the binary protocol spoken over the Unix domain socket between the tone
+ *  server \c toned and its clients, and for the set of functions used to encode, send and receive messages.
+ * @details Every message starts with a header of TONE_MSG_SIZE bytes. Multi-byte fields are stored in little-endian
+ *  order, so the layout does not depend on the compiler:
+ *  | Offset | Size | Field | Meaning                                       |
+ *  |:------:|:----:|:-----:|:----------------------------------------------|
+ *  |    0   |   1  |  cmd  | Command or reply, one of TONE_xxx.            |
+ *  |    1   |   1  |  arg  | Small argument: channel, number of channels or status. |
+ *  |    2   |   2  |   a   | First argument.                               |
+ *  |    4   |   2  |   b   | Second argument.                              |
+ *  |    6   |   2  |   c   | Third argument.                               |
+ *  |    8   |   4  |   d   | Long argument.                                |
+ *
+ * @details The commands sent by a client, and their arguments:
+ *  | cmd              | arg     | a     | b     | c     | d      |
+ *  |:-----------------|:-------:|:-----:|:-----:|:-----:|:------:|
+ *  | TONE_CONFIG      | channel | freq  | phi   | att   | pp     |
+ *  | TONE_FORMAT      | chans   | type  | block | batch | -      |
+ *  | TONE_START       | -       | -     | -     | -     | frames, 0 to stream endlessly |
+ *  | TONE_STOP        | -       | -     | -     | -     | -      |
+ *  | TONE_SUBSCRIBE   | -       | -     | -     | -     | -      |
+ *  | TONE_UNSUBSCRIBE | -       | -     | -     | -     | -      |
+ *  | TONE_QUIT        | -       | -     | -     | -     | -      |
+ *
+ * @details The server answers each command with TONE_ACK, which carries the status in \c arg and the acknowledged
+ *  command in \c a. A subscribed client also receives TONE_DATA messages, which carry the number of channels in
+ *  \c arg, the sample format in \c a and the number of frames in \c d, and are followed by the frames themselves. When
+ *  a run of a limited number of frames is complete, subscribers receive TONE_END with the total number of frames of
+ *  the run in \c d.
+ * @note    This module is intended for the host platform only.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef TONEPROTO_H
+#define TONEPROTO_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "fixtypes.h"
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Default path of the socket of the tone server.
+ */
+#define TONE_SOCKET     "/tmp/toned.sock"
+
+/**@brief   Size of the header of a message, in bytes.
+ */
+#define TONE_MSG_SIZE   (12)
+
+/**@name    Commands sent by clients.
+ * @{
+ */
+#define TONE_CONFIG         (0x01)  /**< Configures a generator. */
+#define TONE_FORMAT         (0x02)  /**< Sets the number of channels and the format of the stream. */
+#define TONE_START          (0x03)  /**< Starts rendering. */
+#define TONE_STOP           (0x04)  /**< Stops rendering. */
+#define TONE_SUBSCRIBE      (0x05)  /**< Subscribes the client to the stream. */
+#define TONE_UNSUBSCRIBE    (0x06)  /**< Unsubscribes the client from the stream. */
+#define TONE_QUIT           (0x07)  /**< Shuts the server down. */
+/**@}*/
+
+/**@name    Messages sent by the server.
+ * @{
+ */
+#define TONE_ACK            (0x81)  /**< Reply to a command. */
+#define TONE_DATA           (0x82)  /**< Batch of rendered frames. */
+#define TONE_END            (0x83)  /**< End of a run. */
+/**@}*/
+
+/**@name    Status codes of replies.
+ * @{
+ */
+#define TONE_OK             (0)     /**< The command is done. */
+#define TONE_EINVAL         (1)     /**< Invalid command or argument. */
+#define TONE_EBUSY          (2)     /**< The command is not allowed while rendering. */
+#define TONE_ENOMEM         (3)     /**< Not enough memory. */
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a decoded header of a message.
+ */
+struct tone_msg_t {
+    ui8_t   cmd;            /**< Command or reply, one of TONE_xxx. */
+    ui8_t   arg;            /**< Small argument. */
+    ui16_t  a;              /**< First argument. */
+    ui16_t  b;              /**< Second argument. */
+    ui16_t  c;              /**< Third argument. */
+    unsigned long   d;      /**< Long argument, 32 bits on the wire. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing the protocol of the tone server.
+ * @{
+ */
+/**@brief   Encodes the header of a message.
+ * @param[in]   pmsg    -- pointer to the decoded header.
+ * @param[out]  pbuf    -- pointer to the buffer of TONE_MSG_SIZE bytes receiving the encoded header.
+ */
+extern void tone_pack(const struct tone_msg_t * const pmsg, ui8_t * const pbuf);
+
+/**@brief   Decodes the header of a message.
+ * @param[in]   pbuf    -- pointer to the buffer of TONE_MSG_SIZE bytes with the encoded header.
+ * @param[out]  pmsg    -- pointer to the structure receiving the decoded header.
+ */
+extern void tone_unpack(const ui8_t * const pbuf, struct tone_msg_t * const pmsg);
+
+/**@brief   Sends a message.
+ * @param[in]   fd      -- socket.
+ * @param[in]   pmsg    -- pointer to the header of the message.
+ * @param[in]   pdata   -- pointer to the payload following the header; may be NULL if \p size is 0.
+ * @param[in]   size    -- size of the payload, in bytes.
+ * @return  The status: 0 if the whole message is sent, non-zero if there was a failure; errno keeps the reason.
+ * @details The header and the payload are sent with a single gathering system call whenever the socket accepts them.
+ */
+extern int tone_send(const int fd, const struct tone_msg_t * const pmsg, const void * const pdata, const size_t size);
+
+/**@brief   Receives exactly the given number of bytes.
+ * @param[in]   fd      -- socket.
+ * @param[out]  pbuf    -- pointer to the buffer receiving the data.
+ * @param[in]   size    -- number of bytes to receive.
+ * @return  The status: 0 if all the bytes are received, non-zero if the peer closed the socket or there was a failure.
+ */
+extern int tone_recv(const int fd, void * const pbuf, const size_t size);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* TONEPROTO_H */
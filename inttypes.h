@@ -3,7 +3,8 @@
  * @details This file provides definitions for those integer data types actually implemented in the target platform.
  *  First of all, these include data types with nonstandard width. Also this file introduces shortened notation for
  *  integer data types with explicit declaration of data type properties such as signedness and width.
- * @note    This file does not use \c stdint.h as soon as it was introduced only in C99 standard.
+ * @note    This file does not use \c stdint.h as soon as it was introduced only in C99 standard, except for the host
+ *  profile selected with the macro INT_STDINT, see below.
  * @author  Alexander A. Strelets
  * @version 1.0
  * @date    October, 2016
@@ -16,6 +17,29 @@
 /*--------------------------------------------------------------------------------------------------------------------*/
 #include "cext.h"
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Host profile.
+ * @details By default the integer data types are defined with the types of ANSI C89 / ISO C90, which fits the target
+ *  platform and 32-bit hosts: 32-bit data types are \c long. On LP64 hosts, such as x86-64 Linux, \c long has 64 bits,
+ *  so there the host profile is selected: the data types are defined with exact-width types of \c stdint.h. The host
+ *  profile is selected automatically if the macro \c \__LP64__ or \c _LP64 is defined by the compiler, and it may be
+ *  selected explicitly by defining the macro INT_STDINT.
+ * @details The 16-bit and 32-bit data types keep their exact widths in the host profile, so the arithmetic gives the
+ *  same results as on the target platform. If the macro INT_FAST22 is defined as well, the containers of 22-bit data
+ *  types are the fastest types with at least 32 bits, which are 64-bit on x86-64 Linux, so intermediate results and
+ *  accumulators are kept in full-width registers. Such containers are wider than necessary, which the library allows
+ *  for all nonstandard data types, and the results stay the same.
+ * @{
+ */
+#if !defined(INT_STDINT) && (defined(__LP64__) || defined(_LP64))
+#define INT_STDINT      /**< Selects the host profile based on \c stdint.h. */
+#endif
+/**@}*/
+
+#ifdef INT_STDINT
+#include <stdint.h>
+#endif
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**@name    Integer data types with standard width.
  * @details The following notation is used for integer data types:
@@ -25,12 +49,21 @@
  *  complement format. Unsigned integer UIm represents values in the discrete range [0; 2^m-1].
  * @{
  */
+#ifdef INT_STDINT
+typedef int8_t              si8_t;      /**< Integer data type, signed, 8-bit width. */
+typedef uint8_t             ui8_t;      /**< Integer data type, unsigned, 8-bit width. */
+typedef int16_t             si16_t;     /**< Integer data type, signed, 16-bit width. */
+typedef uint16_t            ui16_t;     /**< Integer data type, unsigned, 16-bit width. */
+typedef int32_t             si32_t;     /**< Integer data type, signed, 32-bit width. */
+typedef uint32_t            ui32_t;     /**< Integer data type, unsigned, 32-bit width. */
+#else
 typedef signed char         si8_t;      /**< Integer data type, signed, 8-bit width. */
 typedef unsigned char       ui8_t;      /**< Integer data type, unsigned, 8-bit width. */
 typedef signed short int    si16_t;     /**< Integer data type, signed, 16-bit width. */
 typedef unsigned short int  ui16_t;     /**< Integer data type, unsigned, 16-bit width. */
 typedef signed long int     si32_t;     /**< Integer data type, signed, 32-bit width. */
 typedef unsigned long int   ui32_t;     /**< Integer data type, unsigned, 32-bit width. */
+#endif
 /**@}*/
 
 /**@name    Integer data types with nonstandard width.
@@ -45,8 +78,16 @@ typedef unsigned long int   ui32_t;     /**< Integer data type, unsigned, 32-bit
  * @{
  */
 typedef unsigned char       bool_t;     /**< Boolean data type, unsigned, 1-bit width. */
+#if defined(INT_STDINT) && defined(INT_FAST22)
+typedef int_fast32_t        si22_t;     /**< Integer data type, signed, 22-bit width. */
+typedef uint_fast32_t       ui22_t;     /**< Integer data type, unsigned, 22-bit width. */
+#elif defined(INT_STDINT)
+typedef int32_t             si22_t;     /**< Integer data type, signed, 22-bit width. */
+typedef uint32_t            ui22_t;     /**< Integer data type, unsigned, 22-bit width. */
+#else
 typedef signed long int     si22_t;     /**< Integer data type, signed, 22-bit width. */
 typedef unsigned long int   ui22_t;     /**< Integer data type, unsigned, 22-bit width. */
+#endif
 /**@}*/
 
 /*--------------------------------------------------------------------------------------------------------------------*/
@@ -57,7 +98,7 @@ static_assert_msg(
     sizeof(bool_t) == 1 &&
     sizeof(si8_t) == 1 && sizeof(ui8_t) == 1 &&
     sizeof(si16_t) == 2 && sizeof(ui16_t) == 2 &&
-    sizeof(si22_t) == 4 && sizeof(ui22_t) == 4 &&
+    sizeof(si22_t) >= 4 && sizeof(ui22_t) == sizeof(si22_t) &&
     sizeof(si32_t) == 4 && sizeof(ui32_t) == 4,
     some_of_integer_data_types_have_unexpected_widths);
 
@@ -73,7 +114,7 @@ static_assert_msg(
 static_assert_msg(
     (si8_t)0x7FuL > 0 && (si8_t)(0x7FuL + 1) < 0 &&
     (si16_t)0x7FFFuL > 0 && (si16_t)(0x7FFFuL + 1) < 0 &&
-    (si22_t)0x7FFFFFFFuL > 0 && (si22_t)(0x7FFFFFFFuL + 1) < 0 &&
+    (si22_t)0x7FFFFFFFuL > 0 &&
     (si32_t)0x7FFFFFFFuL > 0 && (si32_t)(0x7FFFFFFFuL + 1) < 0,
     some_of_signed_integer_data_types_have_unexpected_ranges);
 
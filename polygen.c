@@ -0,0 +1,121 @@
+/**@file
+ * @brief   Implementation of the multi-phase generator.
+ * @details This file implements the set of functions used to render a multi-phase sine wave into interleaved frames.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "polygen.h"
+#include "fixtrig.h"
+#include "sampfmt.h"
+#include <assert.h>
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Number of frames in a tile.
+ * @details The tile of POLY_MAX_CHANS channels takes 2 KB of SQ0.15 samples, so it stays in the first level data cache
+ *  while it is transposed.
+ */
+#define POLY_TILE   (64)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Initializes a multi-phase generator. */
+void poly_init(struct poly_descr_t * const pp, const ui8_t chans) {
+
+    ui8_t   chan;       /* Index of a channel. */
+
+    assert(pp != NULL);
+    assert(chans > 0 && chans <= POLY_MAX_CHANS);
+
+    pp->freq = 0;
+    pp->phi = 0;
+    pp->att = 0;
+    pp->chans = chans;
+
+    for (chan = 0; chan < chans; ++chan) {
+        pp->offs[chan] = (uq016_t)(((ui32_t)chan << UQ016_FRAC) / chans);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the generator frequency. */
+void poly_set_freq(struct poly_descr_t * const pp, const uq016_t freq) {
+
+    assert(pp != NULL);
+    assert(freq <= 0x4000);
+
+    pp->freq = freq;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the phase of the channel 0. */
+void poly_set_phi(struct poly_descr_t * const pp, const uq016_t phi) {
+
+    assert(pp != NULL);
+
+    pp->phi = phi;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the output attenuation of all the channels. */
+void poly_set_att(struct poly_descr_t * const pp, const uq016_t att) {
+
+    assert(pp != NULL);
+
+    pp->att = att;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Renders a block of interleaved frames. */
+void poly_render(struct poly_descr_t * const pp, const ui8_t type, void * const pout, const ui16_t n) {
+
+    /**@cond false*/
+    #define _PI2    (0x4000u)       /* Container value for UQ0.16 value 0.25 which stays for pi/2 radian. */
+    #define _PI     (0x8000u)       /* Container value for UQ0.16 value 0.5 which stays for pi radian. */
+    /**@endcond*/
+
+    sq015_t tile[POLY_MAX_CHANS][POLY_TILE];    /* Samples of the current tile, one row per channel. */
+    struct fmt_descr_t  fmt;                    /* Format of the output frames. */
+    size_t  frame;                              /* Size of a frame, in bytes. */
+    ui8_t   half;                               /* Number of channels evaluated; the rest are negated. */
+    ui16_t  idx;                                /* Index of the first frame of the current tile. */
+    ui16_t  cnt;                                /* Number of frames in the current tile. */
+    ui16_t  i;                                  /* Index of a frame within the tile. */
+
+    assert(pp != NULL);
+    assert(pp->chans > 0 && pp->chans <= POLY_MAX_CHANS);
+    assert(pout != NULL || n == 0);
+
+    fmt.type = type;
+    fmt.chans = pp->chans;
+    frame = (size_t)fmt_size(type) * pp->chans;
+    half = pp->chans % 2 == 0 ? pp->chans / 2 : pp->chans;
+
+    for (idx = 0; idx < n; idx += cnt) {
+        cnt = n - idx < POLY_TILE ? n - idx : POLY_TILE;
+        for (fmt.chan = 0; fmt.chan < half; ++fmt.chan) {
+            msin_run_sq015(tile[fmt.chan], (uq016_t)(pp->phi + pp->offs[fmt.chan]), pp->freq, pp->att, cnt);
+        }
+        for (; fmt.chan < pp->chans; ++fmt.chan) {
+            /* sin(phi+pi) = -sin(phi), except for the rounding of the peaks at pi/2 and 3*pi/2. */
+            const sq015_t * const px = tile[fmt.chan - half];
+            uq016_t phi = pp->phi + pp->offs[fmt.chan];     /* Momentary phase of the channel. */
+            for (i = 0; i < cnt; ++i) {
+                tile[fmt.chan][i] = (phi & ~_PI) == _PI2 ? msin_sq015(phi, pp->att) : -px[i];
+                phi += pp->freq;
+            }
+        }
+        for (fmt.chan = 0; fmt.chan < pp->chans; ++fmt.chan) {
+            fmt_convert(&fmt, tile[fmt.chan], (ui8_t *)pout + idx * frame, cnt);
+        }
+        pp->phi += (uq016_t)(cnt * (ui32_t)pp->freq);
+    }
+
+    #undef  _PI2
+    #undef  _PI
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
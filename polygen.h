@@ -0,0 +1,85 @@
+/**@file
+ * @brief   Interface to the multi-phase generator.
+ * @details This file provides declarations for the set of functions used to render a multi-phase sine wave - e.g., the
+ *  3-phase or 6-phase supply of a power electronics test bench - into interleaved frames, and declaration of the
+ *  multi-phase generator descriptor data structure.
+ * @details The multi-phase generator has N channels with equally spaced phases: the phase of the channel c is
+ *  phi+c/N modulo 1, or phi+2*pi*c/N radians. All the channels are driven by a single phase accumulator and share the
+ *  frequency and the attenuation. The offsets are truncated to the phase resolution, so the channel c renders the same
+ *  samples as a generator with the phase phi+0x10000*c/N and the postprocessing disabled.
+ * @details When N is even, the channels c and c+N/2 are in antiphase. The quarter-wave folding and the table lookup are
+ *  done once for the pair, and the second channel takes the negated samples of the first one; only the samples at the
+ *  phases pi/2 and 3*pi/2, where the negation of the rounded peak differs by one LSB, are evaluated again. Each
+ *  evaluated channel uses \c msin_run_sq015 over a tile of samples.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef POLYGEN_H
+#define POLYGEN_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "fixtypes.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Maximum number of channels of a multi-phase generator.
+ */
+#define POLY_MAX_CHANS  (16)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a multi-phase generator descriptor.
+ */
+struct poly_descr_t {
+    uq016_t freq;                       /**< Frequency of the oscillator. */
+    uq016_t phi;                        /**< Momentary phase of the channel 0. */
+    uq016_t att;                        /**< Momentary attenuation of the output signals. */
+    ui8_t   chans;                      /**< Number of channels, from 1 to POLY_MAX_CHANS. */
+    uq016_t offs[POLY_MAX_CHANS];       /**< Phase offset of each channel relative to the channel 0. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a multi-phase generator.
+ * @{
+ */
+/**@brief   Initializes a multi-phase generator.
+ * @param[in,out]   pp      -- pointer to the initialized generator descriptor object.
+ * @param[in]       chans   -- number of channels, from 1 to POLY_MAX_CHANS.
+ * @details During initialization the frequency, the phase and the attenuation are set to 0, and the phase offsets of
+ *  the channels are spaced equally.
+ */
+extern void poly_init(struct poly_descr_t * const pp, const ui8_t chans);
+
+/**@brief   Assigns the generator frequency.
+ * @param[in,out]   pp      -- pointer to a generator descriptor object.
+ * @param[in]       freq    -- a new value of the oscillator frequency; see \c gen_set_freq.
+ */
+extern void poly_set_freq(struct poly_descr_t * const pp, const uq016_t freq);
+
+/**@brief   Assigns the phase of the channel 0.
+ * @param[in,out]   pp      -- pointer to a generator descriptor object.
+ * @param[in]       phi     -- a new value of the oscillator phase; see \c gen_set_phi.
+ */
+extern void poly_set_phi(struct poly_descr_t * const pp, const uq016_t phi);
+
+/**@brief   Assigns the output attenuation of all the channels.
+ * @param[in,out]   pp      -- pointer to a generator descriptor object.
+ * @param[in]       att     -- a new value of the output signal attenuation; see \c gen_set_att.
+ */
+extern void poly_set_att(struct poly_descr_t * const pp, const uq016_t att);
+
+/**@brief   Renders a block of interleaved frames.
+ * @param[in,out]   pp      -- pointer to a generator descriptor object.
+ * @param[in]       type    -- format of output samples, one of FMT_xxx; see \c sampfmt.h.
+ * @param[out]      pout    -- pointer to the first frame of the output buffer.
+ * @param[in]       n       -- number of frames to render.
+ * @details The sample of the channel c in the frame f is stored at the position (f*chans + c) of the output buffer,
+ *  counting in samples of the given format, as \c bank_render does.
+ */
+extern void poly_render(struct poly_descr_t * const pp, const ui8_t type, void * const pout, const ui16_t n);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* POLYGEN_H */
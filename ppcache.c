@@ -0,0 +1,279 @@
+/**@file
+ * @brief   Implementation of the cache of the postprocessing lookahead results.
+ * @details This file implements the set of functions used to memoize the results of the lookahead of the
+ *  postprocessing.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "ppcache.h"
+#include <assert.h>
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+static ui16_t ppc_bucket(const struct ppc_descr_t * const pc, const uq016_t phi0, const uq016_t freq,
+    const uq016_t att, const bool_t en);
+static ui16_t ppc_find(const struct ppc_descr_t * const pc, const struct gen_descr_t * const pgen);
+static void ppc_unchain(struct ppc_descr_t * const pc, const ui16_t idx);
+static void ppc_unlink(struct ppc_descr_t * const pc, const ui16_t idx);
+static void ppc_link(struct ppc_descr_t * const pc, const ui16_t idx);
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Initializes a cache. */
+void ppc_init(struct ppc_descr_t * const pc, struct ppc_entry_t * const pents, const ui16_t size,
+    const ppc_lock_t plock, const ppc_lock_t punlock, void * const pctx) {
+
+    ui16_t  idx;        /* Index of the current entry. */
+
+    assert(pc != NULL);
+    assert(pents != NULL);
+    assert(size > 0 && size <= PPC_MAX_SIZE && (size & (size - 1)) == 0);
+    assert((plock == NULL) == (punlock == NULL));
+
+    pc->pents = pents;
+    pc->size = size;
+    pc->used = 0;
+    pc->mru = PPC_NONE;
+    pc->lru = PPC_NONE;
+    pc->plock = plock;
+    pc->punlock = punlock;
+    pc->pctx = pctx;
+    pc->hits = 0;
+    pc->misses = 0;
+    pc->evicts = 0;
+
+    for (idx = 0; idx < size; ++idx) {
+        pents[idx].head = PPC_NONE;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Takes the lookahead result of a generator from the cache. */
+bool_t ppc_load(struct ppc_descr_t * const pc, struct gen_descr_t * const pgen) {
+
+    const struct ppc_entry_t * pe;      /* Entry found. */
+    ui16_t  idx;                        /* Index of the entry found. */
+
+    assert(pc != NULL);
+    assert(pgen != NULL);
+    assert(pgen->pp == 0);
+
+    if (pc->plock != NULL) {
+        pc->plock(pc->pctx);
+    }
+
+    idx = ppc_find(pc, pgen);
+    if (idx == PPC_NONE) {
+        ++(pc->misses);
+    } else {
+        ++(pc->hits);
+        if (idx != pc->mru) {
+            ppc_unlink(pc, idx);
+            ppc_link(pc, idx);
+        }
+        pe = &pc->pents[idx];
+        pgen->fail = 1;
+        if (pe->steps > 0) {
+            pgen->pp = 1;
+            pgen->fail = 0;
+            pgen->phi1 = pe->phi1;
+            pgen->val1 = pe->val1;
+            pgen->sampl = pe->sampl;
+            pgen->steps = pe->steps;
+            pgen->msize = pe->msize;
+            pgen->asize = pe->asize;
+            pgen->ridx = pe->ridx;
+            pgen->aidx = pe->aidx;
+            pgen->sidx = 0;
+        }
+    }
+
+    if (pc->punlock != NULL) {
+        pc->punlock(pc->pctx);
+    }
+
+    return idx != PPC_NONE;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Puts the lookahead result of a generator into the cache. */
+void ppc_save(struct ppc_descr_t * const pc, const struct gen_descr_t * const pgen) {
+
+    struct ppc_entry_t * pe;    /* Entry receiving the result. */
+    ui16_t  idx;                /* Index of the entry. */
+    ui16_t  bkt;                /* Index of the bucket of the entry. */
+
+    assert(pc != NULL);
+    assert(pgen != NULL);
+    assert(pgen->pp || pgen->fail);
+
+    if (pc->plock != NULL) {
+        pc->plock(pc->pctx);
+    }
+
+    if (ppc_find(pc, pgen) == PPC_NONE) {   /* Another generator may have saved the same result since the lookup. */
+        if (pc->used < pc->size) {
+            idx = pc->used++;
+        } else {
+            idx = pc->lru;
+            ppc_unlink(pc, idx);
+            ppc_unchain(pc, idx);
+            ++(pc->evicts);
+        }
+        pe = &pc->pents[idx];
+        pe->phi0 = pgen->phi0;
+        pe->freq = pgen->freq;
+        pe->att = pgen->att;
+        pe->en = pgen->en;
+        pe->steps = 0;
+        if (pgen->pp) {
+            pe->phi1 = pgen->phi1;
+            pe->val1 = pgen->val1;
+            pe->sampl = pgen->sampl;
+            pe->steps = pgen->steps;
+            pe->msize = pgen->msize;
+            pe->asize = pgen->asize;
+            pe->ridx = pgen->ridx;
+            pe->aidx = pgen->aidx;
+        }
+        bkt = ppc_bucket(pc, pgen->phi0, pgen->freq, pgen->att, pgen->en);
+        pe->chain = pc->pents[bkt].head;
+        pc->pents[bkt].head = idx;
+        ppc_link(pc, idx);
+    }
+
+    if (pc->punlock != NULL) {
+        pc->punlock(pc->pctx);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Returns the statistics of a cache. */
+void ppc_stats(struct ppc_descr_t * const pc, unsigned long * const phits, unsigned long * const pmisses,
+    unsigned long * const pevicts) {
+
+    assert(pc != NULL);
+    assert(phits != NULL);
+    assert(pmisses != NULL);
+
+    if (pc->plock != NULL) {
+        pc->plock(pc->pctx);
+    }
+
+    *phits = pc->hits;
+    *pmisses = pc->misses;
+    if (pevicts != NULL) {
+        *pevicts = pc->evicts;
+    }
+
+    if (pc->punlock != NULL) {
+        pc->punlock(pc->pctx);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+ui16_t ppc_bucket(const struct ppc_descr_t * const pc, const uq016_t phi0, const uq016_t freq,
+    const uq016_t att, const bool_t en) {
+
+    ui32_t  key;        /* The key folded into 32 bits. */
+
+    assert(pc != NULL);
+
+    /* The phases of a tone step by freq, so the multiplication spreads them over the upper bits used for the index. */
+    key = (ui32_t)phi0 ^ (ui32_t)freq << 16 ^ (ui32_t)att * 0x9E37u ^ en;
+    key = (key * 0x9E3779B1uL) & 0xFFFFFFFFuL;
+
+    return (ui16_t)(key >> 16) & (pc->size - 1);
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+ui16_t ppc_find(const struct ppc_descr_t * const pc, const struct gen_descr_t * const pgen) {
+
+    const struct ppc_entry_t * pe;      /* Current entry of the bucket. */
+    ui16_t  idx;                        /* Index of the current entry. */
+
+    assert(pc != NULL);
+    assert(pgen != NULL);
+
+    idx = pc->pents[ppc_bucket(pc, pgen->phi0, pgen->freq, pgen->att, pgen->en)].head;
+    for (; idx != PPC_NONE; idx = pe->chain) {
+        pe = &pc->pents[idx];
+        if (pe->phi0 == pgen->phi0 && pe->freq == pgen->freq && pe->att == pgen->att && pe->en == pgen->en) {
+            break;
+        }
+    }
+
+    return idx;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void ppc_unlink(struct ppc_descr_t * const pc, const ui16_t idx) {
+
+    struct ppc_entry_t * pe = &pc->pents[idx];
+
+    assert(pc != NULL);
+    assert(idx < pc->used);
+
+    if (pe->newer == PPC_NONE) {
+        pc->mru = pe->older;
+    } else {
+        pc->pents[pe->newer].older = pe->older;
+    }
+    if (pe->older == PPC_NONE) {
+        pc->lru = pe->newer;
+    } else {
+        pc->pents[pe->older].newer = pe->newer;
+    }
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void ppc_unchain(struct ppc_descr_t * const pc, const ui16_t idx) {
+
+    const struct ppc_entry_t * pe = &pc->pents[idx];
+    ui16_t *pnext;      /* Link to the current entry of the bucket. */
+
+    assert(pc != NULL);
+    assert(idx < pc->used);
+
+    pnext = &pc->pents[ppc_bucket(pc, pe->phi0, pe->freq, pe->att, pe->en)].head;
+    while (*pnext != idx) {
+        assert(*pnext != PPC_NONE);
+        pnext = &pc->pents[*pnext].chain;
+    }
+    *pnext = pe->chain;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void ppc_link(struct ppc_descr_t * const pc, const ui16_t idx) {
+
+    struct ppc_entry_t * pe = &pc->pents[idx];
+
+    assert(pc != NULL);
+    assert(idx < pc->used);
+
+    pe->newer = PPC_NONE;
+    pe->older = pc->mru;
+    if (pc->mru == PPC_NONE) {
+        pc->lru = idx;
+    } else {
+        pc->pents[pc->mru].newer = idx;
+    }
+    pc->mru = idx;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
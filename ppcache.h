@@ -0,0 +1,130 @@
+/**@file
+ * @brief   Interface to the cache of the postprocessing lookahead results.
+ * @details This file provides declarations for the set of functions used to memoize the results of the lookahead of
+ *  the postprocessing, and declaration of the cache descriptor data structure.
+ * @details The lookahead result depends only on phi0, freq, att and en, so a periodic tone runs the same lookaheads
+ *  every period of the phase, and the channels of a bank at the same level run the same ones at the same phases. The
+ *  cache keeps the results by these four attributes - both the postprocessing intervals found and the lookaheads which
+ *  have failed - and a generator attached to the cache with \c gen_set_cache takes a result from it instead of running
+ *  the lookahead again. Once every lookahead of a tone is in the cache, the tone is rendered with no lookahead at all.
+ * @details The cache is bounded: the application provides the array of entries, and when all of them are used, the
+ *  least recently used one is replaced. The entries are found by a hash of the key, with a chain per bucket; there are
+ *  as many buckets as entries, and the bucket heads are kept in the entries themselves.
+ * @details The library has no threads of its own. If generators rendered by several threads share a cache, the
+ *  application gives \c ppc_init a pair of functions to lock and unlock it, e.g. around a mutex; each lookup and each
+ *  update of the cache runs under the lock, while the lookahead itself does not.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef PPCACHE_H
+#define PPCACHE_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "sinegen.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Maximum number of entries in a cache.
+ */
+#define PPC_MAX_SIZE    (0x8000u)
+
+/**@brief   Index of an entry standing for no entry.
+ */
+#define PPC_NONE        (0xFFFFu)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Type of a function locking or unlocking a cache.
+ * @param[in,out]   pctx    -- context given to \c ppc_init.
+ */
+typedef void (*ppc_lock_t)(void * const pctx);
+
+/**@brief   Data structure for an entry of the cache.
+ * @details The result fields have the meaning of the same fields of \c gen_descr_t; steps equal to 0 stands for a
+ *  failed lookahead.
+ */
+struct ppc_entry_t {
+    /* Key. */
+    uq016_t phi0;       /**< The phase the lookahead has started from. */
+    uq016_t freq;       /**< Frequency of the generator. */
+    uq016_t att;        /**< Attenuation of the generator. */
+    bool_t  en;         /**< Postprocessing status of the generator. */
+    /* Result. */
+    uq016_t phi1;       /**< The phase at the right end of the postprocessing interval. */
+    sq015_t val1;       /**< The output value at phi1. */
+    ui16_t  sampl;      /**< Number of samples of the interval. */
+    ui16_t  steps;      /**< Number of main steps of the pattern; 0 if the lookahead has failed. */
+    ui16_t  msize;      /**< Size of a main step, in samples. */
+    ui16_t  asize;      /**< Size of the additional step, in samples. */
+    ui16_t  ridx;       /**< The first index within the first right-hand step of the pattern. */
+    ui16_t  aidx;       /**< The first index within the additional step of the pattern. */
+    /* Links, as indices of the entries. */
+    ui16_t  head;       /**< The first entry of the bucket with the index of this entry. */
+    ui16_t  chain;      /**< The next entry of the same bucket. */
+    ui16_t  newer;      /**< The entry used next after this one. */
+    ui16_t  older;      /**< The entry used last before this one. */
+};
+
+/**@brief   Data structure for a cache descriptor.
+ * @details The statistics count the lookups since \c ppc_init; a miss is followed by the lookahead, and by an update of
+ *  the cache with its result.
+ */
+struct ppc_descr_t {
+    struct ppc_entry_t *pents;      /**< Pointer to the array of entries. */
+    ui16_t  size;                   /**< Number of entries, a power of 2. */
+    ui16_t  used;                   /**< Number of entries used. */
+    ui16_t  mru;                    /**< The most recently used entry. */
+    ui16_t  lru;                    /**< The least recently used entry. */
+    ppc_lock_t  plock;              /**< Function locking the cache; NULL if the cache is not shared by threads. */
+    ppc_lock_t  punlock;            /**< Function unlocking the cache; NULL if the cache is not shared by threads. */
+    void *  pctx;                   /**< Context of the lock functions. */
+    unsigned long   hits;           /**< Number of lookups which have found the result. */
+    unsigned long   misses;         /**< Number of lookups which have not. */
+    unsigned long   evicts;         /**< Number of entries replaced. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a cache of the lookahead results.
+ * @{
+ */
+/**@brief   Initializes a cache.
+ * @param[in,out]   pc      -- pointer to the initialized cache descriptor object.
+ * @param[in,out]   pents   -- pointer to the array of entries.
+ * @param[in]       size    -- number of entries in the array \p pents, a power of 2 up to PPC_MAX_SIZE.
+ * @param[in]       plock   -- function locking the cache; NULL if the cache is used by a single thread.
+ * @param[in]       punlock -- function unlocking the cache; NULL if the cache is used by a single thread.
+ * @param[in,out]   pctx    -- context passed to the lock functions.
+ * @details The cache is empty, and the statistics are reset. The generators attached to the cache shall not be
+ *  rendered while it is initialized.
+ */
+extern void ppc_init(struct ppc_descr_t * const pc, struct ppc_entry_t * const pents, const ui16_t size,
+    const ppc_lock_t plock, const ppc_lock_t punlock, void * const pctx);
+
+/**@brief   Takes the lookahead result of a generator from the cache.
+ * @param[in,out]   pc      -- pointer to a cache descriptor object.
+ * @param[in,out]   pgen    -- pointer to a generator waiting for the lookahead from its phi0.
+ * @return  1 if the result is found, and the generator state is updated as the lookahead would do; 0 otherwise.
+ */
+extern bool_t ppc_load(struct ppc_descr_t * const pc, struct gen_descr_t * const pgen);
+
+/**@brief   Puts the lookahead result of a generator into the cache.
+ * @param[in,out]   pc      -- pointer to a cache descriptor object.
+ * @param[in]       pgen    -- pointer to a generator which has just run the lookahead.
+ * @details The least recently used entry is replaced if all of them are used.
+ */
+extern void ppc_save(struct ppc_descr_t * const pc, const struct gen_descr_t * const pgen);
+
+/**@brief   Returns the statistics of a cache.
+ * @param[in,out]   pc      -- pointer to a cache descriptor object.
+ * @param[out]      phits   -- pointer to the number of lookups which have found the result.
+ * @param[out]      pmisses -- pointer to the number of lookups which have not.
+ * @param[out]      pevicts -- pointer to the number of entries replaced; may be NULL.
+ */
+extern void ppc_stats(struct ppc_descr_t * const pc, unsigned long * const phits, unsigned long * const pmisses,
+    unsigned long * const pevicts);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* PPCACHE_H */
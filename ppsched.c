@@ -0,0 +1,67 @@
+/**@file
+ * @brief   Implementation of the replay of precompiled postprocessing schedules.
+ * @details This file implements the set of functions used to look up precompiled postprocessing schedules.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "ppsched.h"
+#include <assert.h>
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Checks a schedule table. */
+int sched_check(const ui16_t * const ptab, const ui32_t size) {
+
+    ui32_t  pos = SCHED_HEAD;   /* Index of the current tone header. */
+    ui16_t  tone;               /* Index of the current tone. */
+
+    assert(ptab != NULL || size == 0);
+
+    if (size < SCHED_HEAD || ptab[0] != SCHED_MAGIC || ptab[1] != SCHED_VERSION) {
+        return -1;
+    }
+    for (tone = 0; tone < ptab[2]; ++tone) {
+        const ui16_t * ph = ptab + pos;
+        ui16_t  idx;
+        if (size - pos < SCHED_TONE || ph[SCHED_CNT] == 0 || ph[SCHED_LOOP] >= ph[SCHED_CNT] ||
+                (size - pos - SCHED_TONE) / SCHED_ENTRY < ph[SCHED_CNT]) {
+            return -1;
+        }
+        for (idx = 0; idx < ph[SCHED_CNT]; ++idx) {
+            const ui16_t * pe = ph + SCHED_TONE + (ui32_t)idx * SCHED_ENTRY;
+            if (pe[SCHED_STEPS] == 0 ? idx + 1 != ph[SCHED_CNT] :
+                    pe[SCHED_STEPS] < 2 || pe[SCHED_AIDX] > pe[SCHED_RIDX] || pe[SCHED_RIDX] > pe[SCHED_SAMPL]) {
+                return -1;
+            }
+        }
+        pos += SCHED_TONE + (ui32_t)ph[SCHED_CNT] * SCHED_ENTRY;
+    }
+
+    return pos == size ? 0 : -1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Looks up the schedule of a tone. */
+const ui16_t * sched_find(const ui16_t * const ptab, const uq016_t freq, const uq016_t phi, const uq016_t att,
+    const bool_t en) {
+
+    const ui16_t * ph = ptab + SCHED_HEAD;  /* Header of the current tone. */
+    ui16_t  tone;                           /* Index of the current tone. */
+
+    assert(ptab != NULL && ptab[0] == SCHED_MAGIC);
+
+    for (tone = 0; tone < ptab[2]; ++tone) {
+        if (ph[SCHED_FREQ] == freq && ph[SCHED_PHI] == phi && ph[SCHED_ATT] == att && ph[SCHED_EN] == en) {
+            return ph;
+        }
+        ph += SCHED_TONE + (ui32_t)ph[SCHED_CNT] * SCHED_ENTRY;
+    }
+
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
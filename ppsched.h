@@ -0,0 +1,87 @@
+/**@file
+ * @brief   Interface to the replay of precompiled postprocessing schedules.
+ * @details This file provides declarations for the set of functions used to look up precompiled postprocessing
+ *  schedules, and the layout of the schedule tables. The tables are compiled on the host with the \c ppsched tool for
+ *  a known list of test tones, and the generator replays them instead of running \c gen_pp_lookahead; see
+ *  \c gen_set_sched.
+ * @details The lookahead result depends only on phi0, freq, att and en. Starting from a restart, each postprocessing
+ *  interval starts at the phase where the previous one ends, so the sequence of intervals of a tone either ends with a
+ *  failed lookahead, or comes back to a phase it has started from before and repeats from there on. The schedule of a
+ *  tone keeps the intervals up to that point, and the index of the entry where the sequence loops.
+ * @details A schedule table is an array of 16-bit words, so it is the same whether it is compiled into the target as a
+ *  C source or loaded as a binary blob of little-endian words:
+ *  | words       | contents                                                                     |
+ *  |-------------|------------------------------------------------------------------------------|
+ *  | 3           | SCHED_MAGIC, SCHED_VERSION, number of tones                                  |
+ *  | 6 per tone  | freq, phi, att, en, number of entries cnt, index of the entry to loop to     |
+ *  | 9 per entry | phi0, phi1, val1, sampl, steps, msize, asize, ridx, aidx; see \c gen_descr_t |
+ *
+ * @details The entries of a tone follow its header, and the next tone follows its entries. An entry with steps equal
+ *  to 0 stands for a failed lookahead; it is the last one of the tone, and nothing is replayed after it.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef PPSCHED_H
+#define PPSCHED_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "fixtypes.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Layout of schedule tables.
+ * @{
+ */
+#define SCHED_MAGIC     (0x5053u)       /**< The first word of a table, "PS" in little-endian bytes. */
+#define SCHED_VERSION   (1u)            /**< The second word of a table. */
+#define SCHED_HEAD      (3)             /**< Number of words of the table header. */
+#define SCHED_TONE      (6)             /**< Number of words of a tone header. */
+#define SCHED_ENTRY     (9)             /**< Number of words of an entry. */
+
+#define SCHED_FREQ      (0)             /**< Index of freq in a tone header. */
+#define SCHED_PHI       (1)             /**< Index of phi in a tone header. */
+#define SCHED_ATT       (2)             /**< Index of att in a tone header. */
+#define SCHED_EN        (3)             /**< Index of en in a tone header. */
+#define SCHED_CNT       (4)             /**< Index of the number of entries in a tone header. */
+#define SCHED_LOOP      (5)             /**< Index of the entry to loop to in a tone header. */
+
+#define SCHED_PHI0      (0)             /**< Index of phi0 in an entry. */
+#define SCHED_PHI1      (1)             /**< Index of phi1 in an entry. */
+#define SCHED_VAL1      (2)             /**< Index of val1 in an entry, as the 16-bit container code. */
+#define SCHED_SAMPL     (3)             /**< Index of sampl in an entry. */
+#define SCHED_STEPS     (4)             /**< Index of steps in an entry; 0 if the lookahead fails. */
+#define SCHED_MSIZE     (5)             /**< Index of msize in an entry. */
+#define SCHED_ASIZE     (6)             /**< Index of asize in an entry. */
+#define SCHED_RIDX      (7)             /**< Index of ridx in an entry. */
+#define SCHED_AIDX      (8)             /**< Index of aidx in an entry. */
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing lookup of schedule tables.
+ * @{
+ */
+/**@brief   Checks a schedule table.
+ * @param[in]   ptab    -- pointer to the table.
+ * @param[in]   size    -- size of the table, in words.
+ * @return  The status: 0 if the table is well-formed, non-zero otherwise.
+ * @details This function shall be called for a table loaded from a blob before it is given to \c gen_set_sched.
+ */
+extern int sched_check(const ui16_t * const ptab, const ui32_t size);
+
+/**@brief   Looks up the schedule of a tone.
+ * @param[in]   ptab    -- pointer to a well-formed table.
+ * @param[in]   freq    -- frequency of the tone.
+ * @param[in]   phi     -- phase of the tone at the restart.
+ * @param[in]   att     -- attenuation of the tone.
+ * @param[in]   en      -- postprocessing status of the tone.
+ * @return  Pointer to the header of the tone, followed by its entries; NULL if the table has no such tone.
+ */
+extern const ui16_t * sched_find(const ui16_t * const ptab, const uq016_t freq, const uq016_t phi,
+    const uq016_t att, const bool_t en);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* PPSCHED_H */
@@ -0,0 +1,126 @@
+/**@file
+ * @brief   Implementation of the sample format converters.
+ * @details This file implements the set of functions used to convert the generator output samples into the formats
+ *  accepted by different signal sinks.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "sampfmt.h"
+#include <assert.h>
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Number of samples rendered at once before conversion.
+ * @details The chunk shall be small enough to stay in the first level data cache together with the part of the output
+ *  buffer being written.
+ */
+#define FMT_CHUNK   (64)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Returns the size of a sample in the given format. */
+ui8_t fmt_size(const ui8_t type) {
+
+    switch (type) {
+    case FMT_SQ015:
+        return sizeof(sq015_t);
+    case FMT_F32:
+        return sizeof(float);
+    case FMT_S24:
+        return 3;
+    case FMT_S32:
+        return sizeof(si32_t);
+    case FMT_OB16:
+        return sizeof(ui16_t);
+    default:
+        assert(0);
+        return 0;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Converts a block of samples and stores them into the output frames. */
+void fmt_convert(const struct fmt_descr_t * const pfmt, const sq015_t * const px, void * const pout,
+    const ui16_t n) {
+
+    /* Each loop below has no branches and no dependencies between iterations, so the compiler is free to vectorize
+     * it. The stride between samples of the same channel equals the number of channels in a frame. */
+
+    ui16_t  idx;        /* Index of the current sample, which is also the index of the frame. */
+    size_t  step;       /* Number of samples in a frame. */
+
+    assert(pfmt != NULL);
+    assert(pfmt->chans > 0 && pfmt->chan < pfmt->chans);
+    assert(px != NULL || n == 0);
+    assert(pout != NULL || n == 0);
+
+    step = pfmt->chans;
+
+    switch (pfmt->type) {
+    case FMT_SQ015: {
+        sq015_t * const py = (sq015_t *)pout + pfmt->chan;
+        for (idx = 0; idx < n; ++idx) {
+            fmt_put(FMT_SQ015, px[idx], py + idx * step);
+        }
+        break;
+    }
+    case FMT_F32: {
+        float * const py = (float *)pout + pfmt->chan;
+        for (idx = 0; idx < n; ++idx) {
+            fmt_put(FMT_F32, px[idx], py + idx * step);
+        }
+        break;
+    }
+    case FMT_S24: {
+        ui8_t * const py = (ui8_t *)pout + 3 * pfmt->chan;
+        for (idx = 0; idx < n; ++idx) {
+            fmt_put(FMT_S24, px[idx], py + 3 * idx * step);
+        }
+        break;
+    }
+    case FMT_S32: {
+        si32_t * const py = (si32_t *)pout + pfmt->chan;
+        for (idx = 0; idx < n; ++idx) {
+            fmt_put(FMT_S32, px[idx], py + idx * step);
+        }
+        break;
+    }
+    case FMT_OB16: {
+        ui16_t * const py = (ui16_t *)pout + pfmt->chan;
+        for (idx = 0; idx < n; ++idx) {
+            fmt_put(FMT_OB16, px[idx], py + idx * step);
+        }
+        break;
+    }
+    default:
+        assert(0);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Renders a block of the generator output samples in the given format. */
+void gen_render_fmt(struct gen_descr_t * const pgen, const struct fmt_descr_t * const pfmt, void * const pout,
+    const ui16_t n) {
+
+    sq015_t buf[FMT_CHUNK];     /* Chunk of samples rendered but not yet converted. */
+    ui16_t  idx;                /* Index of the first frame of the current chunk. */
+    ui16_t  cnt;                /* Number of samples in the current chunk. */
+    size_t  frame;              /* Size of a frame, in bytes. */
+
+    assert(pgen != NULL);
+    assert(pfmt != NULL);
+    assert(pout != NULL || n == 0);
+
+    frame = (size_t)fmt_size(pfmt->type) * pfmt->chans;
+
+    for (idx = 0; idx < n; idx += cnt) {
+        cnt = n - idx < FMT_CHUNK ? n - idx : FMT_CHUNK;
+        gen_render(pgen, buf, cnt);
+        fmt_convert(pfmt, buf, (ui8_t *)pout + idx * frame, cnt);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,134 @@
+/**@file
+ * @brief   Interface to the sample format converters.
+ * @details This file provides declarations for the set of functions used to convert the generator output samples into
+ *  the formats accepted by different signal sinks, and declaration of the output format descriptor data structure.
+ * @details The generator produces SQ0.15 samples. Sinks on the host side may need them in other formats: as floating
+ *  point values, as wider integers, or as offset binary codes; and they may need samples of several channels
+ *  interleaved in frames. The output format descriptor specifies both the sample format and the position of the
+ *  channel within the frame, so the samples are converted and interleaved in the same pass as they are stored into
+ *  the output buffer.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef SAMPFMT_H
+#define SAMPFMT_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "sinegen.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Output sample formats.
+ * @details The following formats of output samples are supported:
+ *  | format     | container              | code of +1-1/2^15 | code of 0  | code of -1 |
+ *  |------------|------------------------|-------------------|------------|------------|
+ *  | FMT_SQ015  | SQ0.15, 16-bit         | 0x7FFF            | 0x0000     | 0x8000     |
+ *  | FMT_F32    | float, 32-bit          | +0.999969482421875| 0.0        | -1.0       |
+ *  | FMT_S24    | 3 bytes, little endian | 0x7FFF00          | 0x000000   | 0x800000   |
+ *  | FMT_S32    | SI32                   | 0x7FFF0000        | 0x00000000 | 0x80000000 |
+ *  | FMT_OB16   | UI16, offset binary    | 0xFFFF            | 0x8000     | 0x0000     |
+ *
+ * @note    All formats except FMT_S24 are stored with the byte order of the host platform. The FMT_S24 has no native
+ *  container and is always stored as packed 3 bytes in little endian byte order.
+ * @{
+ */
+#define FMT_SQ015   (0)     /**< Signed fixed point SQ0.15, the native format of the generator output. */
+#define FMT_F32     (1)     /**< Single precision floating point in the range [-1.0; +1.0). */
+#define FMT_S24     (2)     /**< Signed integer 24-bit, packed, left-justified SQ0.15 code. */
+#define FMT_S32     (3)     /**< Signed integer 32-bit, left-justified SQ0.15 code. */
+#define FMT_OB16    (4)     /**< Offset binary 16-bit - i.e., SQ0.15 code with the inverted sign bit. */
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for an output format descriptor.
+ * @details Samples are stored into frames of \c chans samples each. The sample of the frame number f which belongs to
+ *  the channel number \c chan is stored at the position (f*chans + chan) of the output buffer, counting in samples of
+ *  the given format. For a mono output \c chans shall be set to 1 and \c chan to 0.
+ */
+struct fmt_descr_t {
+    ui8_t   type;       /**< Format of output samples, one of FMT_xxx. */
+    ui8_t   chans;      /**< Number of channels in a frame, 1 or more. */
+    ui8_t   chan;       /**< Index of the channel within a frame, starting with 0. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing conversion of the generator output.
+ * @{
+ */
+/**@brief   Returns the size of a sample in the given format.
+ * @param[in]   type    -- format of samples, one of FMT_xxx.
+ * @return  Size of one sample, in bytes.
+ */
+extern ui8_t fmt_size(const ui8_t type);
+
+/**@brief   Converts a single sample and stores it into the output buffer.
+ * @param[in]   type    -- format of the output sample, one of FMT_xxx.
+ * @param[in]   x       -- SQ0.15 sample to be converted.
+ * @param[out]  py      -- pointer to the container of the output sample.
+ * @details This is the conversion used by all the functions storing samples in an output format. It is defined
+ *  inline, so when it is called with a constant \p type the choice of the format is resolved at compile time, and a
+ *  loop of calls may be vectorized.
+ * @note    The container shall be aligned as required for the output format, except FMT_S24 which has no alignment
+ *  requirements.
+ */
+INLINE void fmt_put(const ui8_t type, const sq015_t x, void * const py);
+
+/**@brief   Converts a block of samples and stores them into the output frames.
+ * @param[in]   pfmt    -- pointer to the output format descriptor.
+ * @param[in]   px      -- pointer to the array of SQ0.15 samples to be converted.
+ * @param[out]  pout    -- pointer to the first frame of the output buffer.
+ * @param[in]   n       -- number of samples to convert - i.e., the number of frames to fill.
+ * @details Only the samples of the channel given by the format descriptor are written; the samples of other channels
+ *  in the same frames are left untouched.
+ * @note    The output buffer shall be aligned as required for the container of the output format, except FMT_S24 which
+ *  has no alignment requirements.
+ */
+extern void fmt_convert(const struct fmt_descr_t * const pfmt, const sq015_t * const px, void * const pout,
+    const ui16_t n);
+
+/**@brief   Renders a block of the generator output samples in the given format.
+ * @param[in,out]   pgen    -- pointer to a generator descriptor object.
+ * @param[in]       pfmt    -- pointer to the output format descriptor.
+ * @param[out]      pout    -- pointer to the first frame of the output buffer.
+ * @param[in]       n       -- number of samples to render - i.e., the number of frames to fill.
+ * @details This function is equivalent to \c gen_render followed by \c fmt_convert. The samples are rendered in small
+ *  chunks which stay in the processor cache until converted, so the output buffer is written exactly once.
+ */
+extern void gen_render_fmt(struct gen_descr_t * const pgen, const struct fmt_descr_t * const pfmt, void * const pout,
+    const ui16_t n);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+/* Converts a single sample and stores it into the output buffer. */
+INLINE void fmt_put(const ui8_t type, const sq015_t x, void * const py) {
+
+    switch (type) {
+    case FMT_SQ015:
+        *(sq015_t *)py = x;
+        break;
+    case FMT_F32:
+        *(float *)py = x * (1.0f / 32768.0f);
+        break;
+    case FMT_S24:
+        ((ui8_t *)py)[0] = 0;
+        ((ui8_t *)py)[1] = (ui8_t)((ui16_t)x & 0xFF);
+        ((ui8_t *)py)[2] = (ui8_t)((ui16_t)x >> 8);
+        break;
+    case FMT_S32:
+        *(si32_t *)py = (si32_t)x * 0x10000L;
+        break;
+    case FMT_OB16:
+        *(ui16_t *)py = (ui16_t)x ^ 0x8000u;
+        break;
+    default:
+        break;
+    }
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* SAMPFMT_H */
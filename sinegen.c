@@ -10,14 +10,22 @@
 /*--------------------------------------------------------------------------------------------------------------------*/
 #include "sinegen.h"
 #include "fixtrig.h"
+#include "ppcache.h"
+#include "ppsched.h"
 #include <assert.h>
 #include <stddef.h>
+#include <string.h>
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**@cond false*/
+static void gen_classify(struct gen_descr_t * const pgen);
 static void gen_pp_restart(struct gen_descr_t * const pgen);
+static void gen_pp_next(struct gen_descr_t * const pgen);
+static void gen_pp_replay(struct gen_descr_t * const pgen);
+#ifndef GEN_NO_LOOKAHEAD
 static void gen_pp_lookahead(struct gen_descr_t * const pgen);
 static ui16_t sqrt_ui16(const ui16_t x);
+#endif
 /**@endcond*/
 
 /*--------------------------------------------------------------------------------------------------------------------*/
@@ -30,7 +38,10 @@ void gen_init(struct gen_descr_t * const pgen) {
     pgen->phi = 0;
     pgen->att = 0;
     pgen->en = 0;
+    pgen->ptab = NULL;
+    pgen->pcache = NULL;
 
+    gen_classify(pgen);
     gen_pp_restart(pgen);
 }
 
@@ -65,6 +76,7 @@ void gen_set_att(struct gen_descr_t * const pgen, const uq016_t att) {
 
     pgen->att = att;
 
+    gen_classify(pgen);
     gen_pp_restart(pgen);
 }
 
@@ -79,6 +91,45 @@ void gen_set_pp(struct gen_descr_t * const pgen, const bool_t en) {
     gen_pp_restart(pgen);
 }
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the generator frequency, phase, output attenuation and postprocessing status at once. */
+void gen_set_params(struct gen_descr_t * const pgen, const struct gen_params_t * const pprm) {
+
+    assert(pgen != NULL);
+    assert(pprm != NULL);
+    assert(pprm->freq <= 0x4000);
+
+    pgen->freq = pprm->freq;
+    pgen->phi = pprm->phi;
+    pgen->en = pprm->en;
+    if (pgen->att != pprm->att) {
+        pgen->att = pprm->att;
+        gen_classify(pgen);
+    }
+
+    gen_pp_restart(pgen);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the table of precompiled postprocessing schedules. */
+void gen_set_sched(struct gen_descr_t * const pgen, const ui16_t * const ptab) {
+
+    assert(pgen != NULL);
+
+    pgen->ptab = ptab;
+
+    gen_pp_restart(pgen);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Assigns the cache of the lookahead results. */
+void gen_set_cache(struct gen_descr_t * const pgen, struct ppc_descr_t * const pc) {
+
+    assert(pgen != NULL);
+
+    pgen->pcache = pc;
+}
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /* Returns the generator momentary output. */
 sq015_t gen_output(const struct gen_descr_t * const pgen) {
@@ -126,12 +177,130 @@ void gen_step(struct gen_descr_t * const pgen) {
         pgen->phi0 = pgen->phi1;
         pgen->val0 = pgen->val1;
         pgen->pp = 0;
+        pgen->fail = 0;
     }
-    if (pgen->pp == 0) {
-        gen_pp_lookahead(pgen);
+    if (pgen->pp == 0 && pgen->fail == 0) {   /* The lookahead result depends only on phi0, freq, att, and en. */
+        gen_pp_next(pgen);
     }
 }
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Propagates the generator state for several sampling steps without producing the output. */
+void gen_skip(struct gen_descr_t * const pgen, ui32_t n) {
+
+    assert(pgen != NULL);
+
+    if (pgen->freq == 0) {
+        return;
+    }
+
+    while (n > 0 && (pgen->pp || pgen->fail == 0)) {
+        if (pgen->pp && pgen->sidx + 1uL < pgen->sampl) {   /* Only phi and sidx change short of the interval end. */
+            ui32_t  cnt = pgen->sampl - pgen->sidx - 1uL;
+            if (cnt > n) {
+                cnt = n;
+            }
+            pgen->sidx += (ui16_t)cnt;
+            pgen->phi += (ui16_t)(cnt * pgen->freq);
+            n -= cnt;
+        } else {
+            gen_step(pgen);
+            --n;
+        }
+    }
+
+    pgen->sidx += (ui16_t)n;                /* Nothing but the phase changes until the next restart. */
+    pgen->phi += (ui16_t)(n * pgen->freq);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Renders a block of the generator output samples. */
+void gen_render(struct gen_descr_t * const pgen, sq015_t * const pout, const ui16_t n) {
+
+    /**@cond false*/
+    #define _PI     (0x8000u)       /* Container value for UQ0.16 value 0.5 which stays for pi radian. */
+    #define _PI_M   (0x7FFFu)       /* Bit mask for the phase modulo pi radian. */
+    /**@endcond*/
+
+    ui16_t  idx;        /* Index of the current sample within the block. */
+
+    assert(pgen != NULL);
+    assert(pout != NULL || n == 0);
+
+    for (idx = 0; idx < n; ++idx) {
+        if (pgen->freq == 0) {
+            sq015_t val = gen_output(pgen);     /* The output does not change while the generator is paused. */
+            for (; idx < n; ++idx) {
+                pout[idx] = val;
+            }
+            return;
+        }
+        if (pgen->pp == 0 && pgen->fail) {      /* Nothing but the phase changes until the next restart. */
+            break;
+        }
+        pout[idx] = gen_output(pgen);
+        gen_step(pgen);
+    }
+
+    pgen->sidx += n - idx;
+    if (pgen->tern && pgen->thr > _PI / 2) {
+        memset(pout + idx, 0, (n - idx) * sizeof(*pout));
+        pgen->phi += (ui16_t)((n - idx) * (ui32_t)pgen->freq);
+    } else if (pgen->tern) {
+        for (; idx < n; ++idx) {
+            uq016_t phi1 = pgen->phi & _PI_M;   /* Phase modulo pi radian. */
+            sq015_t val = phi1 >= pgen->thr && phi1 <= _PI - pgen->thr;
+            pout[idx] = pgen->phi & _PI ? -val : val;
+            pgen->phi += pgen->freq;
+        }
+    } else {
+        pgen->phi = msin_run_sq015(pout + idx, pgen->phi, pgen->freq, pgen->att, n - idx);
+    }
+
+    #undef  _PI
+    #undef  _PI_M
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void gen_classify(struct gen_descr_t * const pgen) {
+
+    /**@cond false*/
+    #define _PI2    (0x4000u)       /* Container value for UQ0.16 value 0.25 which stays for pi/2 radian. */
+    /**@endcond*/
+
+    uq016_t lo, hi;     /* Range of phases bracketing the threshold. */
+
+    assert(pgen != NULL);
+
+    /* The output amplitude reaches its maximum at pi/2. If it does not exceed one LSB, the output takes only values
+     * -1, 0, +1, and it is +1 on the range of phases [thr; pi-thr] and -1 on [pi+thr; 2*pi-thr]. Such attenuation codes
+     * are 0xFFFD and 0xFFFE, for which msin_sq015 is monotone in the first quadrant (this was checked exhaustively);
+     * and 0xFFFF, for which the output is constantly 0 and thr is set beyond pi/2. */
+    pgen->tern = msin_sq015(_PI2, pgen->att) <= 1;
+    if (pgen->tern == 0) {
+        return;
+    }
+    if (msin_sq015(_PI2, pgen->att) == 0) {
+        pgen->thr = _PI2 + 1;
+        return;
+    }
+    lo = 0;
+    hi = _PI2;
+    while (hi - lo > 1) {
+        uq016_t mid = lo + (hi - lo) / 2;   /* Middle of the range. */
+        if (msin_sq015(mid, pgen->att) > 0) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    pgen->thr = hi;
+
+    #undef  _PI2
+}
+/**@endcond*/
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**@cond false*/
 void gen_pp_restart(struct gen_descr_t * const pgen) {
@@ -141,13 +310,81 @@ void gen_pp_restart(struct gen_descr_t * const pgen) {
     pgen->phi0 = pgen->phi;
     pgen->val0 = msin_sq015(pgen->phi0, pgen->att);
     pgen->pp = 0;
+    pgen->fail = 0;
+    pgen->ptone = pgen->ptab != NULL ? sched_find(pgen->ptab, pgen->freq, pgen->phi, pgen->att, pgen->en) : NULL;
+    pgen->sent = 0;
 
     if (pgen->freq > 0) {
-        gen_pp_lookahead(pgen);
+        gen_pp_next(pgen);
+    }
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void gen_pp_next(struct gen_descr_t * const pgen) {
+
+    assert(pgen != NULL);
+
+    if (pgen->ptone != NULL) {
+        gen_pp_replay(pgen);
+        return;
     }
+    if (pgen->pcache != NULL && ppc_load(pgen->pcache, pgen)) {
+        return;
+    }
+#ifndef GEN_NO_LOOKAHEAD
+    gen_pp_lookahead(pgen);
+    if (pgen->pcache != NULL) {
+        ppc_save(pgen->pcache, pgen);
+    }
+#else
+    pgen->fail = 1;
+#endif
 }
 /**@endcond*/
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void gen_pp_replay(struct gen_descr_t * const pgen) {
+
+    const ui16_t * pe;      /* The next entry of the schedule. */
+
+    assert(pgen != NULL);
+    assert(pgen->pp == 0);
+
+    pe = pgen->ptone + SCHED_TONE + (ui32_t)pgen->sent * SCHED_ENTRY;
+    if (pe[SCHED_PHI0] != pgen->phi0) {     /* Only a table not compiled from this library may get here. */
+        pgen->ptone = NULL;
+        gen_pp_next(pgen);
+        return;
+    }
+
+    pgen->fail = 1;         /* Cleared below if the entry holds a postprocessing interval. */
+    if (pe[SCHED_STEPS] == 0) {
+        return;
+    }
+    pgen->pp = 1;
+    pgen->fail = 0;
+    pgen->phi1 = pe[SCHED_PHI1];
+    pgen->val1 = (sq015_t)pe[SCHED_VAL1];
+    pgen->sampl = pe[SCHED_SAMPL];
+    pgen->steps = pe[SCHED_STEPS];
+    pgen->msize = pe[SCHED_MSIZE];
+    pgen->asize = pe[SCHED_ASIZE];
+    pgen->ridx = pe[SCHED_RIDX];
+    pgen->aidx = pe[SCHED_AIDX];
+    pgen->sidx = 0;
+
+    ++(pgen->sent);
+    if (pgen->sent == pgen->ptone[SCHED_CNT]) {
+        pgen->sent = pgen->ptone[SCHED_LOOP];
+    }
+}
+/**@endcond*/
+
+#ifndef GEN_NO_LOOKAHEAD
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**@cond false*/
 void gen_pp_lookahead(struct gen_descr_t * const pgen) {
@@ -159,6 +396,8 @@ void gen_pp_lookahead(struct gen_descr_t * const pgen) {
     assert(pgen->freq > 0 && pgen->freq <= 0x4000);
     assert(pgen->pp == 0);
 
+    pgen->fail = 1;     /* Cleared below if the postprocessing interval is found. */
+
     if (pgen->en == 0) {
         return;
     }
@@ -200,6 +439,7 @@ void gen_pp_lookahead(struct gen_descr_t * const pgen) {
     pgen->steps = sqrt_ui16(pgen->sampl);
     if (pgen->steps >= 2) {
         pgen->pp = 1;
+        pgen->fail = 0;
         pgen->phi1 += cnt2 / 2 * pgen->freq;
         pgen->msize = pgen->sampl / pgen->steps;
         pgen->asize = pgen->sampl % pgen->steps;
@@ -247,4 +487,6 @@ ui16_t sqrt_ui16(const ui16_t x) {
 }
 /**@endcond*/
 
+#endif /* GEN_NO_LOOKAHEAD */
+
 /*--------------------------------------------------------------------------------------------------------------------*/
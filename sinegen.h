@@ -14,6 +14,9 @@
 /*--------------------------------------------------------------------------------------------------------------------*/
 #include "fixtypes.h"
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+struct ppc_descr_t;     /* Cache of the lookahead results, see ppcache.h. */
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**@brief   Data structure for a sine wave generator descriptor.
  */
@@ -22,11 +25,14 @@ struct gen_descr_t {
     uq016_t freq;       /**< Frequency of the oscillator. */
     uq016_t phi;        /**< Momentary phase of the oscillator. */
     uq016_t att;        /**< Momentary attenuation of the output signal. */
+    bool_t  tern;       /**< Equals to 1 if the output signal takes only values -1, 0, +1; 0 otherwise. */
+    uq016_t thr;        /**< Least phase in the first quadrant with the output +1. Valid only if tern is 1. */
     /* Postprocessor state and attributes. */
     uq016_t phi0;       /**< Momentary phase of the oscillator at the start of the postprocessing interval. */
     sq015_t val0;       /**< Momentary amplitude of the output signal at phi0. */
     bool_t  en;         /**< Equals to 1 if the postprocessing is enabled; 0 otherwise. */
     bool_t  pp;         /**< Equals to 1 if the postprocessing is allowed; 0 otherwise. */
+    bool_t  fail;       /**< Equals to 1 if the lookahead from phi0 is known to fail; 0 if it is not evaluated yet. */
     uq016_t phi1;       /**< Momentary phase of the oscillator at the left-end of the postprocessing interval. */
     sq015_t val1;       /**< Momentary amplitude of the output signal at phi1. */
     uq016_t phi2;       /**< Momentary phase of the oscillator at the right-end of the postprocessing interval. */
@@ -38,6 +44,21 @@ struct gen_descr_t {
     ui16_t  sidx;       /**< Index of the current sample within the interval from phi0 to phi1, starting with 0. */
     ui16_t  ridx;       /**< The first index within the first right-hand step of the pattern. */
     ui16_t  aidx;       /**< The first index within the additional step of the pattern. */
+    /* Replay of precompiled schedules. */
+    const ui16_t *ptab;     /**< Schedule table given with \c gen_set_sched; NULL if none. */
+    const ui16_t *ptone;    /**< Schedule of the tone being replayed, see \c ppsched.h; NULL if none. */
+    ui16_t  sent;       /**< Index of the next entry of the schedule to replay. */
+    /* Memoization of the lookahead results. */
+    struct ppc_descr_t *pcache;     /**< Cache given with \c gen_set_cache; NULL if none. */
+};
+
+/**@brief   Data structure for a set of the generator attributes assigned at once.
+ */
+struct gen_params_t {
+    uq016_t freq;       /**< Frequency of the oscillator; see \c gen_set_freq. */
+    uq016_t phi;        /**< Phase of the oscillator; see \c gen_set_phi. */
+    uq016_t att;        /**< Attenuation of the output signal; see \c gen_set_att. */
+    bool_t  en;         /**< Postprocessing status; see \c gen_set_pp. */
 };
 
 /*--------------------------------------------------------------------------------------------------------------------*/
@@ -115,6 +136,35 @@ extern void gen_set_att(struct gen_descr_t * const pgen, const uq016_t att);
  */
 extern void gen_set_pp(struct gen_descr_t * const pgen, const bool_t en);
 
+/**@brief   Assigns the generator frequency, phase, output attenuation and postprocessing status at once.
+ * @param[in,out]   pgen    -- pointer to a generator descriptor object.
+ * @param[in]       pprm    -- pointer to the set of new attribute values.
+ * @details The result is the same as calling \c gen_set_freq, \c gen_set_phi, \c gen_set_att and \c gen_set_pp in
+ *  turn, but the postprocessing is restarted only once, and the attenuation is classified only if it changes.
+ */
+extern void gen_set_params(struct gen_descr_t * const pgen, const struct gen_params_t * const pprm);
+
+/**@brief   Assigns the table of precompiled postprocessing schedules.
+ * @param[in,out]   pgen    -- pointer to a generator descriptor object.
+ * @param[in]       ptab    -- pointer to a well-formed schedule table, see \c ppsched.h; NULL to detach the table.
+ * @details At each restart the generator looks up the schedule of its tone - i.e., of its freq, phi, att and pp - in
+ *  the table. If it is found, the postprocessing intervals are taken from the schedule instead of being evaluated by
+ *  the lookahead, and the output is the same. Otherwise the lookahead is run as usual. The table shall outlive its use
+ *  by the generator.
+ * @note    If the library is built with GEN_NO_LOOKAHEAD defined, the lookahead is not compiled at all; tones not found
+ *  in the table are rendered with the postprocessing disabled.
+ */
+extern void gen_set_sched(struct gen_descr_t * const pgen, const ui16_t * const ptab);
+
+/**@brief   Assigns the cache of the lookahead results.
+ * @param[in,out]   pgen    -- pointer to a generator descriptor object.
+ * @param[in,out]   pc      -- pointer to an initialized cache, see \c ppcache.h; NULL to detach the cache.
+ * @details The generator takes the lookahead results from the cache when they are there, and puts the results of the
+ *  lookaheads it runs into it. The output is the same, so the generator is not restarted. A schedule given with
+ *  \c gen_set_sched takes precedence over the cache. The cache shall outlive its use by the generator.
+ */
+extern void gen_set_cache(struct gen_descr_t * const pgen, struct ppc_descr_t * const pc);
+
 /**@brief   Returns the generator momentary output.
  * @param[in]   pgen    -- pointer to a generator descriptor object.
  * @return  Momentary amplitude of the generated signal.
@@ -154,6 +204,29 @@ extern sq015_t gen_output(const struct gen_descr_t * const pgen);
  * @note    For the generator to work properly this function shall be called exactly one time per each sampling period.
  */
 extern void gen_step(struct gen_descr_t * const pgen);
+
+/**@brief   Propagates the generator state for several sampling steps without producing the output.
+ * @param[in,out]   pgen    -- pointer to a generator descriptor object.
+ * @param[in]       n       -- number of sampling steps.
+ * @details This function is equivalent to calling \c gen_step for \p n times. The steps inside a postprocessing
+ *  interval, and the steps after the lookahead has failed, are done at once; \c gen_step is called one by one only
+ *  where the postprocessing interval ends and the lookahead is run.
+ */
+extern void gen_skip(struct gen_descr_t * const pgen, ui32_t n);
+
+/**@brief   Renders a block of the generator output samples.
+ * @param[in,out]   pgen    -- pointer to a generator descriptor object.
+ * @param[out]      pout    -- pointer to the array receiving the generated samples.
+ * @param[in]       n       -- number of samples to render.
+ * @details This function is equivalent to calling \c gen_output followed by \c gen_step for \p n times, and storing
+ *  the values returned by \c gen_output into the array \p pout. The generator state after this function returns is
+ *  the same as it would be after such a sequence of calls.
+ * @details If the generator output is known to be constant, or to take only values -1, 0, +1 for the rest of the
+ *  block, the samples are produced without evaluation of the phase-to-sine table. This is the case when the
+ *  generator is paused, and when the attenuation is so high that the amplitude of the output signal does not exceed
+ *  one LSB while the postprocessing is not active.
+ */
+extern void gen_render(struct gen_descr_t * const pgen, sq015_t * const pout, const ui16_t n);
 /**@}*/
 
 /*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,675 @@
+/**@file
+ * @brief   Header-only C++ interface to the sine wave generator.
+ * @details This file provides the class template \c sinegen::SineGen which wraps the sine wave generator for use in C++
+ *  code. The phase-to-sine evaluation is selected at compile time with the \c Backend parameter, and the widths of the
+ *  phase accumulator and of intermediate values with the \c StateBits and \c IntermediateBits parameters, so the
+ *  render loop is instantiated for the given combination and inlined into the caller, with no dispatch at run time.
+ * @details The following backends are provided:
+ *  | backend             | bit-exact | postprocessing | widths          | deviation | method                          |
+ *  |---------------------|-----------|----------------|-----------------|-----------|---------------------------------|
+ *  | backend::Reference  | yes       | yes            | 16 / 22 only    | 0         | calls the C \c msin_sq015       |
+ *  | backend::Lut        | yes       | yes            | 16 / 22 only    | 0         | inline copy of \c msin_sq015    |
+ *  | backend::Cordic     | no        | no             | 16..32 / 18..30 | 2         | CORDIC rotations                |
+ *  | backend::Poly       | no        | no             | 16..32 / 18..30 | 1 / 2     | Taylor polynomial of degree 11  |
+ *  | backend::Recursive  | no        | no             | 16..32 / 18..30 | 50 / 2    | recurrence, re-seeded by CORDIC |
+ *
+ * @details The deviation is the maximum one from \c gen_render without the postprocessing, in LSB of SQ0.15, with the
+ *  widths 16 / 22 and 32 / 30 where they differ; \c tools/gencmp measures it, and fails if it exceeds the bound given
+ *  here. The recurrence deviates the most with a 16-bit phase: 2*cos(freq) is rounded to I-2 fractional bits, and at
+ *  the lowest frequencies the error of the coefficient grows over the samples between re-seeds.
+ * @details Bit-exact backends keep the generator state in a C \c gen_descr_t object, so the C API stays the reference:
+ *  their output matches \c gen_render sample by sample, including the postprocessing. Blocks are rendered with
+ *  \c gen_render itself, which evaluates the plain sine past the postprocessing with \c msin_run_sq015, faster than
+ *  a loop over samples; the backend evaluates the momentary output outside the postprocessing intervals. Other
+ *  backends implement only the plain modulated sine; they trade exactness for the width of the phase accumulator
+ *  and precision.
+ * @details The class template \c sinegen::FixedTone is the generator of a tone whose attributes are known at compile
+ *  time: its whole output, including the postprocessing, is evaluated at compile time into a table. The phase-to-sine
+ *  table \c sinegen::qsin_table is built at compile time as well, from the same formula as the table of the C library.
+ * @details A backend is a class with the static member \c exact, and the member class template
+ *  \c kernel<StateBits, IntermediateBits> with the following members:
+ *  - void reset(std::uint32_t phi, std::uint32_t freq)     -- called when the phase or the frequency is assigned.
+ *  - sq015_t sample(std::uint32_t phi, uq016_t att) const  -- returns the output at the current phase.
+ *  - void advance(std::uint32_t phi)                       -- called after the phase has been advanced to \p phi.
+ *
+ * @note    This file requires C++20.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef SINEGEN_HPP
+#define SINEGEN_HPP
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+extern "C" {
+#include "fixtrig.h"
+#include "sinegen.h"
+}
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+namespace sinegen {
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+namespace detail {
+
+/* Returns sqrt(x) for x >= 0, evaluated with the Newton method at compile time. */
+constexpr long double sqrt(const long double x) {
+    long double r = x > 1 ? x : 1;
+    for (int i = 0; i < 64; ++i) {
+        r = (r + x / r) / 2;
+    }
+    return r;
+}
+
+/* Returns atan(x) for 0 <= x <= 1/2, evaluated with the Taylor series at compile time. */
+constexpr long double atan(const long double x) {
+    long double sum = 0, pow = x;
+    for (int k = 0; k < 64; ++k) {
+        sum += (k & 1 ? -pow : pow) / (2 * k + 1);
+        pow *= x * x;
+    }
+    return sum;
+}
+
+constexpr long double pi = 3.14159265358979323846264338327950288L;
+
+/* Rounds a non-negative value to the nearest integer at compile time. */
+constexpr std::int64_t round(const long double x) {
+    return static_cast<std::int64_t>(x + 0.5L);
+}
+
+/* Scales the absolute value of sin(phi) with F fractional bits by (1-att) and rounds it to SQ0.15. */
+template <unsigned F>
+constexpr sq015_t finish(const std::int64_t val, const uq016_t att) {
+    const std::int64_t mag = val < 0 ? -val : val;
+    std::int64_t res = (mag * (0x10000 - att) + (std::int64_t(1) << F)) >> (F + 1);
+    if (res > 0x7FFF) {
+        res = 0x7FFF;
+    }
+    return static_cast<sq015_t>(val < 0 ? -res : res);
+}
+
+/* Constants of the CORDIC with F fractional bits. */
+template <unsigned F>
+struct cordic_tables {
+    std::int64_t atan[F];       /* Angles atan(2^-i), radians. */
+    std::int64_t gain;          /* Inverse of the CORDIC gain. */
+    std::int64_t pi2;           /* pi/2, radians. */
+
+    constexpr cordic_tables() : atan(), gain(), pi2(round(pi / 2 * (std::int64_t(1) << F))) {
+        long double k = 1;
+        for (unsigned i = 0; i < F; ++i) {
+            const long double t = 1.0L / (std::int64_t(1) << i);
+            atan[i] = round((i == 0 ? pi / 4 : detail::atan(t)) * (std::int64_t(1) << F));
+            k /= detail::sqrt(1 + t * t);
+        }
+        gain = round(k * (std::int64_t(1) << F));
+    }
+};
+
+template <unsigned F>
+inline constexpr cordic_tables<F> cordic_tbl{};
+
+/* Returns sin and cos of the phase of S bits, with F fractional bits. */
+template <unsigned S, unsigned F>
+constexpr void cordic(const std::uint32_t phi, std::int64_t &sin, std::int64_t &cos) {
+    const cordic_tables<F> &tbl = cordic_tbl<F>;
+    const unsigned quad = phi >> (S - 2);
+    const std::uint64_t rem = phi & ((std::uint64_t(1) << (S - 2)) - 1);
+    std::int64_t x = tbl.gain, y = 0;
+    std::int64_t z = static_cast<std::int64_t>((rem * tbl.pi2) >> (S - 2));
+
+    for (unsigned i = 0; i < F; ++i) {
+        const std::int64_t dx = y >> i, dy = x >> i;
+        if (z >= 0) {
+            x -= dx;
+            y += dy;
+            z -= tbl.atan[i];
+        } else {
+            x += dx;
+            y -= dy;
+            z += tbl.atan[i];
+        }
+    }
+    switch (quad) {
+    case 0: sin = +y; cos = +x; break;
+    case 1: sin = +x; cos = -y; break;
+    case 2: sin = -y; cos = -x; break;
+    default: sin = -x; cos = +y; break;
+    }
+}
+
+/* Validates the widths of a backend which is not bit-exact. */
+template <unsigned S, unsigned I>
+constexpr bool valid_widths = S >= 16 && S <= 32 && I >= 18 && I <= 30;
+
+/* Returns sin(x) for 0 <= x <= pi/2, evaluated with the Taylor series at compile time. */
+constexpr long double sin(const long double x) {
+    long double sum = 0, pow = x;
+    for (int k = 0; k < 32; ++k) {
+        sum += pow;
+        pow *= -x * x / ((2 * k + 2) * (2 * k + 3));
+    }
+    return sum;
+}
+
+/* Builds the phase-to-sine table of msin_sq015: sin(key*pi/512) in UQ0.16, rounded to the nearest. */
+constexpr std::array<uq016_t, 256> qsin_make() {
+    std::array<uq016_t, 256> tbl{};
+    for (unsigned key = 0; key < tbl.size(); ++key) {
+        tbl[key] = static_cast<uq016_t>(round(sin(pi * key / 512) * 0x10000));
+    }
+    return tbl;
+}
+
+inline constexpr std::array<uq016_t, 256> qsin_tbl = qsin_make();
+
+/* Returns the same as msin_sq015, evaluated with the table built at compile time. */
+constexpr sq015_t msin(const std::uint32_t phi, const uq016_t att) {
+    std::uint32_t phi1 = phi & 0x7FFF, usin;
+    sq015_t ssin;
+    if (phi == 0x4000 || phi == 0xC000) {
+        ssin = static_cast<sq015_t>(att == 0 ? 0x7FFF : (0x10000 - att) >> 1);
+        return phi == 0x4000 ? ssin : static_cast<sq015_t>(att == 0 ? -0x8000 : -ssin);
+    }
+    if (phi1 > 0x4000) {
+        phi1 = 0x8000 - phi1;
+    }
+    usin = qsin_tbl[phi1 >> 6];
+    if (phi1 & 0x3F) {
+        const std::uint32_t coef = (phi1 & 0x3F) << 10;
+        const std::uint32_t key1 = (phi1 >> 6) + 1;
+        usin = ((usin * (0x10000 - coef)) >> 16) + (key1 == 0x100 ? coef : (qsin_tbl[key1] * coef) >> 16);
+    }
+    if (att > 0) {
+        usin = (usin * (0x10000u - att)) >> 16;
+    }
+    ssin = static_cast<sq015_t>((usin >> 1) + ((usin & 1) && (usin >> 1) < 0x7FFF));
+    return phi & 0x8000 ? static_cast<sq015_t>(-ssin) : ssin;
+}
+
+/* Model of the generator state of sinegen.c which can be evaluated at compile time. The functions follow gen_output,
+ * gen_step, gen_pp_restart and gen_pp_lookahead statement by statement; the classification is left out because it
+ * changes only the way gen_render evaluates msin_sq015, not its output. */
+struct gen_model {
+    uq016_t freq = 0, phi = 0, att = 0;
+    bool en = false, pp = false, fail = false;
+    uq016_t phi0 = 0, phi1 = 0, phi2 = 0;
+    sq015_t val0 = 0, val1 = 0, val2 = 0;
+    ui16_t steps = 0, sampl = 0, msize = 0, asize = 0, sidx = 0, ridx = 0, aidx = 0;
+
+    /* Returns the same as sqrt_ui16, including the saturation of arguments beyond its table. */
+    static constexpr ui16_t isqrt(const ui16_t x) {
+        ui16_t key = 0;
+        while (key < 128 && key * key <= x) {
+            ++key;
+        }
+        return static_cast<ui16_t>(key - 1);
+    }
+
+    constexpr void restart() {
+        phi0 = phi;
+        val0 = msin(phi0, att);
+        pp = false;
+        fail = false;
+        if (freq > 0) {
+            lookahead();
+        }
+    }
+
+    constexpr void lookahead() {
+        ui16_t cnt1 = 0, cnt2 = 0;
+        fail = true;
+        if (!en) {
+            return;
+        }
+        phi1 = phi0;
+        while (true) {
+            phi1 += freq;
+            ++cnt1;
+            if (phi1 - phi0 >= 0x4000 || cnt1 >= 0x4000) {
+                return;
+            }
+            val1 = msin(phi1, att);
+            if (val1 != val0) {
+                break;
+            }
+        }
+        const sq015_t dval = static_cast<sq015_t>(val1 - val0);
+        if (dval < -1 || dval > 1) {
+            return;
+        }
+        phi2 = phi1;
+        while (true) {
+            phi2 += freq;
+            ++cnt2;
+            if (phi2 - phi1 >= 0x4000 || cnt2 >= 0x4000) {
+                return;
+            }
+            val2 = msin(phi2, att);
+            if (val2 != val1) {
+                break;
+            }
+        }
+        sampl = static_cast<ui16_t>(cnt1 + cnt2 / 2);
+        steps = isqrt(sampl);
+        if (steps >= 2) {
+            pp = true;
+            fail = false;
+            phi1 += cnt2 / 2 * freq;
+            msize = static_cast<ui16_t>(sampl / steps);
+            asize = static_cast<ui16_t>(sampl % steps);
+            sidx = 0;
+            ridx = static_cast<ui16_t>(sampl - (steps / 2) * msize);
+            aidx = static_cast<ui16_t>(ridx - asize);
+        }
+    }
+
+    constexpr sq015_t output() const {
+        if (!pp) {
+            return msin(phi, att);
+        }
+        if (sidx >= aidx && sidx < ridx) {
+            return (sidx - aidx) & 1 ? val0 : val1;
+        }
+        const ui16_t midx = static_cast<ui16_t>(sidx >= ridx ? sidx - asize : sidx);
+        const ui16_t istep = midx / msize, iidx = midx % msize, pidx = iidx % steps;
+        return pidx >= istep ? val0 : val1;
+    }
+
+    constexpr void step() {
+        if (freq == 0) {
+            return;
+        }
+        phi += freq;
+        ++sidx;
+        if (pp && sidx == sampl) {
+            phi0 = phi1;
+            val0 = val1;
+            pp = false;
+            fail = false;
+        }
+        if (!pp && !fail) {
+            lookahead();
+        }
+    }
+
+    /* Returns true if both models produce the same output from now on. */
+    constexpr bool same(const gen_model &other) const {
+        if (freq != other.freq || phi != other.phi || att != other.att || en != other.en || pp != other.pp ||
+                fail != other.fail || phi0 != other.phi0 || val0 != other.val0) {
+            return false;
+        }
+        return !pp || (phi1 == other.phi1 && val1 == other.val1 && steps == other.steps && sampl == other.sampl &&
+            msize == other.msize && asize == other.asize && sidx == other.sidx && ridx == other.ridx &&
+            aidx == other.aidx);
+    }
+};
+
+} /* namespace detail */
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Phase-to-sine table of \c msin_sq015 built at compile time; it equals \c qsin_lut of the C library.
+ */
+inline constexpr const std::array<uq016_t, 256> &qsin_table = detail::qsin_tbl;
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Phase-to-sine backends.
+ */
+namespace backend {
+
+/**@brief   Reference backend: calls \c msin_sq015 of the C library.
+ */
+struct Reference {
+    static constexpr bool exact = true;     /**< The backend reproduces \c msin_sq015 bit-exactly. */
+
+    template <unsigned S, unsigned I>
+    struct kernel {
+        static_assert(S == 16 && I == 22, "the reference backend supports only the widths of the C library");
+        void reset(std::uint32_t, std::uint32_t) {}
+        sq015_t sample(const std::uint32_t phi, const uq016_t att) const {
+            return msin_sq015(static_cast<uq016_t>(phi), att);
+        }
+        void advance(std::uint32_t) {}
+    };
+};
+
+/**@brief   Inline lookup table backend: the algorithm of \c msin_sq015 with \c qsin_table, compiled into the caller.
+ */
+struct Lut {
+    static constexpr bool exact = true;     /**< The backend reproduces \c msin_sq015 bit-exactly. */
+
+    template <unsigned S, unsigned I>
+    struct kernel {
+        static_assert(S == 16 && I == 22, "the LUT backend supports only the widths of the C library");
+        void reset(std::uint32_t, std::uint32_t) {}
+        sq015_t sample(const std::uint32_t phi, const uq016_t att) const {
+            return detail::msin(phi, att);
+        }
+        void advance(std::uint32_t) {}
+    };
+};
+
+/**@brief   CORDIC backend: evaluates sin with (IntermediateBits - 2) rotations.
+ */
+struct Cordic {
+    static constexpr bool exact = false;    /**< The backend is not bit-exact with \c msin_sq015. */
+
+    template <unsigned S, unsigned I>
+    struct kernel {
+        static_assert(detail::valid_widths<S, I>, "unsupported widths");
+        void reset(std::uint32_t, std::uint32_t) {}
+        sq015_t sample(const std::uint32_t phi, const uq016_t att) const {
+            std::int64_t sin, cos;
+            detail::cordic<S, I - 2>(phi, sin, cos);
+            return detail::finish<I - 2>(sin, att);
+        }
+        void advance(std::uint32_t) {}
+    };
+};
+
+/**@brief   Polynomial backend: evaluates sin on the first quadrant with the Taylor polynomial of degree 11.
+ */
+struct Poly {
+    static constexpr bool exact = false;    /**< The backend is not bit-exact with \c msin_sq015. */
+
+    template <unsigned S, unsigned I>
+    struct kernel {
+        static_assert(detail::valid_widths<S, I>, "unsupported widths");
+        static constexpr unsigned F = I - 2;    /* Number of fractional bits. */
+        static constexpr std::int64_t one = std::int64_t(1) << F;
+        static constexpr std::int64_t coefs[6] = {
+            one, -detail::round(one / 6.0L), detail::round(one / 120.0L), -detail::round(one / 5040.0L),
+            detail::round(one / 362880.0L), -detail::round(one / 39916800.0L),
+        };
+        void reset(std::uint32_t, std::uint32_t) {}
+        sq015_t sample(const std::uint32_t phi, const uq016_t att) const {
+            constexpr std::uint32_t half = std::uint32_t(1) << (S - 1), quarter = half >> 1;
+            constexpr std::int64_t pi2 = detail::round(detail::pi / 2 * one);
+            std::uint64_t phi1 = phi & (half - 1);
+            std::int64_t x, x2, acc;
+            int k;
+            if (phi1 > quarter) {
+                phi1 = half - phi1;
+            }
+            x = static_cast<std::int64_t>((phi1 * pi2) >> (S - 2));
+            x2 = (x * x) >> F;
+            acc = coefs[5];
+            for (k = 4; k >= 0; --k) {
+                acc = coefs[k] + ((acc * x2) >> F);
+            }
+            acc = (acc * x) >> F;
+            return detail::finish<F>(phi & half ? -acc : acc, att);
+        }
+        void advance(std::uint32_t) {}
+    };
+};
+
+/**@brief   Recursive backend: sin(phi + freq) = 2*cos(freq)*sin(phi) - sin(phi - freq).
+ * @details The recurrence needs one multiplication per sample. Its rounding errors accumulate the faster the lower the
+ *  frequency is, so the state is re-seeded with the CORDIC every \c period samples.
+ */
+struct Recursive {
+    static constexpr bool exact = false;    /**< The backend is not bit-exact with \c msin_sq015. */
+    static constexpr unsigned period = 32;  /**< Number of samples between re-seeds. */
+
+    template <unsigned S, unsigned I>
+    struct kernel {
+        static_assert(detail::valid_widths<S, I>, "unsupported widths");
+        static constexpr unsigned F = I - 2;    /* Number of fractional bits. */
+        std::uint32_t freq = 0;                 /* Frequency. */
+        unsigned cnt = 0;                       /* Number of samples since the last re-seed. */
+        std::int64_t coef = 0, y0 = 0, y1 = 0;  /* 2*cos(freq), sin(phi - freq) and sin(phi). */
+
+        void reset(const std::uint32_t phi, const std::uint32_t f) {
+            std::int64_t sin, cos;
+            freq = f;
+            detail::cordic<S, F>(f, sin, cos);
+            coef = 2 * cos;
+            seed(phi);
+        }
+        sq015_t sample(std::uint32_t, const uq016_t att) const {
+            return detail::finish<F>(y1, att);
+        }
+        void advance(const std::uint32_t phi) {
+            if (++cnt == period) {
+                seed(phi);
+            } else {
+                const std::int64_t y2 = ((coef * y1 + (std::int64_t(1) << (F - 1))) >> F) - y0;
+                y0 = y1;
+                y1 = y2;
+            }
+        }
+
+    private:
+        void seed(const std::uint32_t phi) {
+            const std::uint32_t mask = static_cast<std::uint32_t>((std::uint64_t(1) << S) - 1);
+            std::int64_t cos;
+            detail::cordic<S, F>((phi - freq) & mask, y0, cos);
+            detail::cordic<S, F>(phi, y1, cos);
+            cnt = 0;
+        }
+    };
+};
+
+} /* namespace backend */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Sine wave generator.
+ * @tparam  Backend             -- phase-to-sine backend, one of \c backend::xxx.
+ * @tparam  StateBits           -- width of the phase accumulator and of the frequency, in bits.
+ * @tparam  IntermediateBits    -- width of intermediate values of the backend, in bits.
+ * @details The phase and the frequency are unsigned fractions of the turn with \c StateBits bits; the attenuation is
+ *  UQ0.16 and the output is SQ0.15, as in the C API. The frequency shall not exceed the quarter of the turn.
+ */
+template <class Backend = backend::Lut, unsigned StateBits = 16, unsigned IntermediateBits = 22>
+class SineGen {
+public:
+    /**@brief   Type of the phase and the frequency. */
+    using phase_type = std::conditional_t<(StateBits <= 16), std::uint16_t, std::uint32_t>;
+    /**@brief   Type of the backend. */
+    using backend_type = Backend;
+
+    /**@brief   Initializes the generator as \c gen_init does. */
+    SineGen() {
+        gen_init(&descr_);
+        kernel_.reset(0, 0);
+    }
+
+    /**@brief   Assigns the frequency; see \c gen_set_freq. */
+    void set_freq(const phase_type freq) {
+        assert(freq <= quarter);
+        if constexpr (Backend::exact) {
+            gen_set_freq(&descr_, freq);
+        } else {
+            freq_ = freq;
+            kernel_.reset(phi_, freq_);
+        }
+    }
+
+    /**@brief   Assigns the phase; see \c gen_set_phi. */
+    void set_phi(const phase_type phi) {
+        if constexpr (Backend::exact) {
+            gen_set_phi(&descr_, phi);
+        } else {
+            phi_ = phi & mask;
+            kernel_.reset(phi_, freq_);
+        }
+    }
+
+    /**@brief   Assigns the attenuation; see \c gen_set_att. */
+    void set_att(const uq016_t att) {
+        if constexpr (Backend::exact) {
+            gen_set_att(&descr_, att);
+        } else {
+            att_ = att;
+        }
+    }
+
+    /**@brief   Enables or disables the postprocessing; see \c gen_set_pp. Available with bit-exact backends only. */
+    void set_pp(const bool en) requires (Backend::exact) {
+        gen_set_pp(&descr_, en);
+    }
+
+    /**@brief   Returns the momentary output; see \c gen_output. */
+    sq015_t output() const {
+        if constexpr (Backend::exact) {
+            return descr_.pp ? gen_output(&descr_) : kernel_.sample(descr_.phi, descr_.att);
+        } else {
+            return kernel_.sample(phi_, att_);
+        }
+    }
+
+    /**@brief   Propagates the state for one sampling step; see \c gen_step. */
+    void step() {
+        if constexpr (Backend::exact) {
+            gen_step(&descr_);
+        } else if (freq_ != 0) {
+            phi_ = (phi_ + freq_) & mask;
+            kernel_.advance(phi_);
+        }
+    }
+
+    /**@brief   Renders a block of samples; see \c gen_render.
+     * @param[out]  out -- span receiving the samples; any number of samples may be rendered at once.
+     */
+    void render(const std::span<sq015_t> out) {
+        sq015_t * pout = out.data();
+        std::size_t n = out.size();
+
+        if constexpr (Backend::exact) {
+            /* The C code runs the postprocessing and its lookaheads, and renders the rest of the block with
+             * msin_run_sq015 as soon as nothing but the phase changes until the next restart. */
+            while (n > 0) {
+                const ui16_t cnt = static_cast<ui16_t>(std::min<std::size_t>(n, 0xFFFF));
+                gen_render(&descr_, pout, cnt);
+                pout += cnt;
+                n -= cnt;
+            }
+        } else {
+            for (; n > 0; --n) {
+                *pout++ = kernel_.sample(phi_, att_);
+                if (freq_ != 0) {
+                    phi_ = (phi_ + freq_) & mask;
+                    kernel_.advance(phi_);
+                }
+            }
+        }
+    }
+
+    /**@brief   Returns the C descriptor of the generator. Available with bit-exact backends only. */
+    const gen_descr_t &descr() const requires (Backend::exact) {
+        return descr_;
+    }
+
+private:
+    static constexpr std::uint32_t mask = static_cast<std::uint32_t>((std::uint64_t(1) << StateBits) - 1);
+    static constexpr std::uint32_t quarter = std::uint32_t(1) << (StateBits - 2);
+
+    gen_descr_t descr_{};                                               /* State of bit-exact backends. */
+    phase_type  phi_ = 0, freq_ = 0;                                    /* Phase and frequency of other backends. */
+    uq016_t     att_ = 0;                                               /* Attenuation of other backends. */
+    typename Backend::template kernel<StateBits, IntermediateBits> kernel_; /* Phase-to-sine kernel. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Generator of a tone fixed at compile time, rendered from a precomputed table.
+ * @tparam  Freq    -- frequency, as \c gen_set_freq accepts it; shall not be 0.
+ * @tparam  Att     -- attenuation, as \c gen_set_att accepts it.
+ * @tparam  Phi     -- initial phase, as \c gen_set_phi accepts it.
+ * @tparam  En      -- postprocessing status, as \c gen_set_pp accepts it.
+ * @details The output of the C generator restarted with these attributes is evaluated at compile time, including the
+ *  postprocessing patterns found by the lookahead, so rendering is a copy from a table. The output repeats with the
+ *  period of the phase, \c period samples, except for the first period: the lookahead runs from the restart phase and
+ *  not from the phase at which the previous period ended. The table holds both periods, and the compilation fails if
+ *  the state of the generator at the end of the second period differs from the state at its start.
+ * @note    The table takes 4*period bytes, and the compile time grows with the period, which is 2^16 samples for odd
+ *  frequencies; the class is intended for tones with the frequency code divisible by a large power of 2. Periods
+ *  longer than a few thousand samples exceed the default limit of GCC on constexpr evaluation, which is raised with
+ *  -fconstexpr-ops-limit (about 2^32 for 2^16 samples).
+ */
+template <uq016_t Freq, uq016_t Att, uq016_t Phi = 0, bool En = true>
+class FixedTone {
+    static_assert(Freq > 0 && Freq <= 0x4000, "the frequency shall be in the range 1...0x4000");
+
+public:
+    /**@brief   Period of the phase, in samples. */
+    static constexpr std::size_t period = std::size_t(0x10000) / (Freq & -Freq);
+
+    /**@brief   Output starting with the restart: the first period, then the period which repeats. */
+    static constexpr std::array<sq015_t, 2 * period> table = [] {
+        std::array<sq015_t, 2 * period> out{};
+        detail::gen_model gen, mid;
+        gen.freq = Freq;
+        gen.phi = Phi;
+        gen.att = Att;
+        gen.en = En;
+        gen.restart();
+        for (std::size_t idx = 0; idx < out.size(); ++idx) {
+            if (idx == period) {
+                mid = gen;
+            }
+            out[idx] = gen.output();
+            gen.step();
+        }
+        if (!gen.same(mid)) {
+            throw "the output does not repeat with the period of the phase";
+        }
+        return out;
+    }();
+
+    /**@brief   Returns the momentary output; see \c gen_output. */
+    sq015_t output() const {
+        return table[idx_];
+    }
+
+    /**@brief   Propagates the state for one sampling step; see \c gen_step. */
+    void step() {
+        idx_ = idx_ + 1 < table.size() ? idx_ + 1 : period;
+    }
+
+    /**@brief   Renders a block of samples; see \c gen_render.
+     * @param[out]  out -- span receiving the samples; any number of samples may be rendered at once.
+     */
+    void render(const std::span<sq015_t> out) {
+        sq015_t * pout = out.data();
+        std::size_t n = out.size();
+
+        while (n > 0) {
+            const std::size_t cnt = table.size() - idx_ < n ? table.size() - idx_ : n;
+            std::copy_n(table.begin() + idx_, cnt, pout);
+            pout += cnt;
+            n -= cnt;
+            idx_ += cnt;
+            if (idx_ == table.size()) {
+                idx_ = period;
+            }
+        }
+    }
+
+    /**@brief   Restarts the output, as assigning the attributes to a C generator does. */
+    void restart() {
+        idx_ = 0;
+    }
+
+private:
+    std::size_t idx_ = 0;       /* Index of the momentary output in the table. */
+};
+
+} /* namespace sinegen */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* SINEGEN_HPP */
@@ -0,0 +1,211 @@
+/**@file
+ * @brief   Implementation of the tone meter.
+ * @details This file implements the set of functions used to measure the amplitude and the phase of a sine wave signal
+ *  at a single given frequency.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "tonemeter.h"
+#include "fixtrig.h"
+#include "fixmath.h"
+#include <assert.h>
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Number of samples summed up in the 22-bit intermediate accumulators before merging into the meter state.
+ * @details Each product of a sample and a reference value is rounded to SQ0.15 and does not exceed 1.0 in magnitude.
+ *  The sum of 32 such products does not exceed 32.0 in magnitude and fits into the signed 22-bit intermediate.
+ */
+#define TM_GROUP    (32)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+static si22_t tm_mul(const sq015_t x, const sq015_t y);
+static void tm_merge(struct tm_descr_t * const ptm, const si22_t sre, const si22_t sim);
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Initializes a tone meter. */
+void tm_init(struct tm_descr_t * const ptm, const uq016_t freq) {
+
+    assert(ptm != NULL);
+    assert(freq <= 0x4000);
+
+    ptm->freq = freq;
+    ptm->phi = 0;
+    ptm->re = 0;
+    ptm->im = 0;
+    ptm->rre = 0;
+    ptm->rim = 0;
+    ptm->exp = 0;
+    ptm->cnt = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Feeds a block of samples of the analyzed signal to a tone meter. */
+void tm_feed(struct tm_descr_t * const ptm, const sq015_t * const px, const ui16_t n) {
+
+    /**@cond false*/
+    #define _PI2    (0x4000u)       /* Container value for UQ0.16 value 0.25 which stays for pi/2 radian. */
+    /**@endcond*/
+
+    ui16_t  idx;        /* Index of the current sample within the block. */
+    ui8_t   grp;        /* Number of samples summed up in the intermediate accumulators. */
+    si22_t  sre, sim;   /* Intermediate sums of products with sin(phi) and cos(phi), SQ5.15. */
+
+    assert(ptm != NULL);
+    assert(px != NULL || n == 0);
+    assert(n <= 0xFFFF - ptm->cnt);
+
+    sre = 0;
+    sim = 0;
+    grp = 0;
+    for (idx = 0; idx < n; ++idx) {
+        sre += tm_mul(px[idx], msin_sq015(ptm->phi, 0));
+        sim += tm_mul(px[idx], msin_sq015((uq016_t)(ptm->phi + _PI2), 0));
+        ptm->phi += ptm->freq;
+        if (++grp == TM_GROUP) {
+            tm_merge(ptm, sre, sim);
+            sre = 0;
+            sim = 0;
+            grp = 0;
+        }
+    }
+    if (grp > 0) {
+        tm_merge(ptm, sre, sim);
+    }
+
+    ptm->cnt += n;
+
+    #undef  _PI2
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/* Returns the amplitude and the phase of the measured tone. */
+void tm_result(const struct tm_descr_t * const ptm, uq016_t * const pamp, uq016_t * const pphi) {
+
+    /**@cond false*/
+    #define _PI     (0x8000u)       /* Container value for UQ0.16 value 0.5 which stays for pi radian. */
+    #define _1K     (0x9B75u)       /* Container value for UQ0.16 value 1/K, where K is the CORDIC gain. */
+    #define _GUARD  (4)             /* Number of guard bits appended to the mantissas for the CORDIC iterations. */
+    #define _SCALE  (11)            /* Maximum allowed left shift of the magnitude before division. */
+    /**@endcond*/
+
+    /* Angles atan(2^-i) for i = 0, 1, ... 15 in terms of the UQ0.16 phase scaled to the range [0; 2*pi). */
+    static const uq016_t atan_lut[] = {
+        8192, 4836, 2555, 1297, 651, 326, 163, 81, 41, 20, 10, 5, 3, 1, 1, 0,
+    };
+
+    si22_t  x, y;       /* Coordinates of the rotated vector, with guard bits. */
+    uq016_t z;          /* Accumulated angle of rotation. */
+    ui8_t   i;          /* Index of the CORDIC iteration. */
+    ui32_t  mag;        /* Magnitude of the vector, in terms of mantissas of the meter state with guard bits. */
+    ui8_t   sh;         /* Total left shift of the magnitude to obtain the amplitude. */
+    ui8_t   sh1;        /* Part of the shift performed before division. */
+    ui32_t  amp;        /* Amplitude of the tone, UQ0.16 not yet saturated. */
+    ui32_t  rem;        /* Remainder of the division. */
+
+    assert(ptm != NULL);
+    assert(pamp != NULL && pphi != NULL);
+
+    if (ptm->cnt == 0) {
+        *pamp = 0;
+        *pphi = 0;
+        return;
+    }
+
+    /* The guard bits are taken from the top of the remainders. */
+    x = (si22_t)ptm->re * BIT(_GUARD) + (si22_t)(((ui32_t)ptm->rre << _GUARD) >> ptm->exp);
+    y = (si22_t)ptm->im * BIT(_GUARD) + (si22_t)(((ui32_t)ptm->rim << _GUARD) >> ptm->exp);
+    z = 0;
+    if (x < 0) {
+        x = -x;
+        y = -y;
+        z = _PI;
+    }
+    for (i = 0; i < ARRAY_SIZE(atan_lut); ++i) {
+        si22_t xi = x;      /* Value of x before the current iteration. */
+        if (y > 0) {
+            x += y >> i;
+            y -= xi >> i;
+            z += atan_lut[i];
+        } else {
+            x -= y >> i;
+            y += xi >> i;
+            z -= atan_lut[i];
+        }
+    }
+
+    /* The sum of products of a sine with amplitude A by the reference sine over N samples equals A*N/2. The amplitude
+     * in terms of UQ0.16 is then 2*2*|v|/N, where |v| is the length of the vector in terms of SQ0.15, and mag keeps the
+     * value of |v| scaled down by the exponent, with the guard bits. The division is continued over the bits shifted
+     * after it, so the amplitude keeps all the bits of mag. */
+    mag = (ui32_t)x;
+    mag = ((mag >> 8) * _1K + ((mag & 0xFF) * _1K >> 8) + 0x80) >> 8;
+    if (ptm->exp + 2 < _GUARD) {
+        sh = (ui8_t)(_GUARD - 2 - ptm->exp);
+        amp = (mag + ((ui32_t)ptm->cnt << sh) / 2) / ((ui32_t)ptm->cnt << sh);
+    } else {
+        sh = (ui8_t)(ptm->exp + 2 - _GUARD);
+        sh1 = sh < _SCALE ? sh : _SCALE;
+        amp = (mag << sh1) / ptm->cnt;
+        rem = (mag << sh1) % ptm->cnt;
+        amp = (amp << (sh - sh1)) + ((rem << (sh - sh1)) + ptm->cnt / 2) / ptm->cnt;
+    }
+    if (amp > BIT_MASK(UQ016_BIT)) {
+        amp = BIT_MASK(UQ016_BIT);
+    }
+
+    *pamp = (uq016_t)amp;
+    *pphi = z;
+
+    #undef  _PI
+    #undef  _1K
+    #undef  _GUARD
+    #undef  _SCALE
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+si22_t tm_mul(const sq015_t x, const sq015_t y) {
+    return ((si32_t)x * y + (si32_t)BIT(SQ015_FRAC - 1)) >> SQ015_FRAC;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+void tm_merge(struct tm_descr_t * const ptm, const si22_t sre, const si22_t sim) {
+
+    si22_t  re, im;     /* Sums of the remainders and the intermediate sums, and then new values of mantissas. */
+    ui32_t  mask;       /* Mask of the bits below the least significant bit of the mantissas. */
+
+    assert(ptm != NULL);
+
+    /* The value of a sum is (m << exp) + r, where the remainder r in the range [0; 2^exp) keeps the bits dropped from
+     * the mantissa m, so no part of the sums is lost while the exponent grows. The products are below 1.0 in magnitude,
+     * so the sums of up to 65535 of them stay below 2^31, the exponent does not exceed 16 and r fits 16 bits. */
+    mask = BIT_MASK(ptm->exp);
+    re = ptm->rre + sre;
+    im = ptm->rim + sim;
+    ptm->rre = (ui16_t)(re & mask);
+    ptm->rim = (ui16_t)(im & mask);
+    re = ptm->re + (re >> ptm->exp);
+    im = ptm->im + (im >> ptm->exp);
+    while (re >= 0x8000 || re < -0x8000 || im >= 0x8000 || im < -0x8000) {
+        ptm->rre |= (ui16_t)((re & 1) << ptm->exp);
+        ptm->rim |= (ui16_t)((im & 1) << ptm->exp);
+        re >>= 1;
+        im >>= 1;
+        ++(ptm->exp);
+    }
+
+    ptm->re = (sq015_t)re;
+    ptm->im = (sq015_t)im;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,96 @@
+/**@file
+ * @brief   Interface to the tone meter.
+ * @details This file provides declarations for the set of functions used to measure the amplitude and the phase of a
+ *  sine wave signal at a single given frequency, and declaration of the tone meter descriptor data structure.
+ * @details The tone meter evaluates the single bin of the discrete Fourier transform of the analyzed signal at the
+ *  given frequency. It is intended for closed-loop verification of the sine wave generator output: the signal
+ *  produced by the generator (or recorded after passing through the device under test) is fed to the meter block by
+ *  block, and at the end of the measurement the meter returns the amplitude and the initial phase of the tone. The
+ *  frequency and the phase are represented in the same way as for the sine wave generator, so the measured values may
+ *  be compared directly with the generator attributes.
+ * @details The meter follows the same rules as the generator: 16 bits of precision for storing of the state in memory,
+ *  and up to 22 bits of precision for intermediate arithmetic results. The accumulated correlation sums are kept in
+ *  the block floating point format: two 16-bit mantissas share the common binary exponent which is incremented each
+ *  time the sums grow out of the 16-bit range. The bits below the least significant bits of the mantissas are kept in
+ *  16-bit remainders, so the sums are exact whatever the exponent is.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+#ifndef TONEMETER_H
+#define TONEMETER_H
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "fixtypes.h"
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a tone meter descriptor.
+ */
+struct tm_descr_t {
+    uq016_t freq;       /**< Frequency of the reference oscillator. */
+    uq016_t phi;        /**< Momentary phase of the reference oscillator. */
+    sq015_t re;         /**< Mantissa of the sum of products of the signal with sin(phi), the in-phase component. */
+    sq015_t im;         /**< Mantissa of the sum of products of the signal with cos(phi), the quadrature component. */
+    ui16_t  rre;        /**< Remainder of the in-phase sum below the least significant bit of its mantissa. */
+    ui16_t  rim;        /**< Remainder of the quadrature sum below the least significant bit of its mantissa. */
+    ui8_t   exp;        /**< Binary exponent shared by both mantissas. */
+    ui16_t  cnt;        /**< Number of samples accumulated since the meter initialization. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@name    Set of functions providing interface to a tone meter.
+ * @{
+ */
+/**@brief   Initializes a tone meter.
+ * @param[in,out]   ptm     -- pointer to the initialized tone meter descriptor object.
+ * @param[in]       freq    -- the frequency of the measured tone in terms of the sampling frequency - i.e., the ratio
+ *  Fo/Fs, where Fo is the tone fequency and Fs is the sampling frequency, both in hertz.
+ * @details The allowed values of \p freq are the same as for the sine wave generator, see \c gen_set_freq.
+ * @details During initialization the accumulated sums are cleared and the phase of the reference oscillator is set to
+ *  0. The phase returned by \c tm_result is therefore the phase of the measured tone at the first sample fed to the
+ *  meter after its initialization.
+ */
+extern void tm_init(struct tm_descr_t * const ptm, const uq016_t freq);
+
+/**@brief   Feeds a block of samples of the analyzed signal to a tone meter.
+ * @param[in,out]   ptm     -- pointer to a tone meter descriptor object.
+ * @param[in]       px      -- pointer to the array of samples of the analyzed signal.
+ * @param[in]       n       -- number of samples in the array \p px.
+ * @details This function may be called any number of times with blocks of arbitrary sizes between the meter
+ *  initialization and the evaluation of the result. However, the total number of samples fed to the meter must not
+ *  exceed 65535.
+ * @details Each sample is multiplied by sin(phi) and cos(phi) of the reference oscillator, where the reference values
+ *  are taken from the same phase-to-sine table as the generator output. Products are rounded to SQ0.15 and summed up
+ *  in the 22-bit intermediate accumulators over groups of 32 samples; after each group the intermediate sums are
+ *  merged into the 16-bit block floating point state of the meter and its remainders.
+ * @note    For the result to be unbiased the number of samples fed to the meter should cover an integer number of
+ *  periods of the measured tone.
+ */
+extern void tm_feed(struct tm_descr_t * const ptm, const sq015_t * const px, const ui16_t n);
+
+/**@brief   Returns the amplitude and the phase of the measured tone.
+ * @param[in]   ptm     -- pointer to a tone meter descriptor object.
+ * @param[out]  pamp    -- pointer to the variable receiving the amplitude of the measured tone.
+ * @param[out]  pphi    -- pointer to the variable receiving the initial phase of the measured tone.
+ * @details The amplitude and the phase are evaluated with the CORDIC algorithm in vectoring mode which needs only
+ *  shifts and additions. The amplitude is then normalized by the number of accumulated samples.
+ * @details The amplitude is returned as the UQ0.16 value in the discrete range [0.0; 1.0-1/2^16] with resolution of
+ *  1/2^16, the same as for the value of (1-att) of the sine wave generator. The value 1.0 is saturated to 1.0-1/2^16.
+ * @details The phase is returned as the UQ0.16 value in the discrete range [0.0; 1.0-1/2^16] with resolution of
+ *  1/2^16 scaled to the range [0; 2*pi), the same as for the phase of the sine wave generator. It is the phase of the
+ *  measured tone sin(phi) at the first sample fed to the meter.
+ * @details When whole periods of the tone are fed, the result differs from the bin of the discrete Fourier transform
+ *  of the fed samples, evaluated exactly, by the rounding of the products and of the reference values only. The
+ *  amplitude is within 2 LSB of the exact one, and the phase is within 3 + 4096/A LSB of the exact one, where A is the
+ *  amplitude in LSB: at the full scale the phase is within 3 LSB, and it is meaningless for amplitudes below about 16.
+ *  The bounds are checked by the \c meter suite of \c tools/refcheck.
+ * @note    If no samples were fed to the meter, both the amplitude and the phase are returned as 0.
+ */
+extern void tm_result(const struct tm_descr_t * const ptm, uq016_t * const pamp, uq016_t * const pphi);
+/**@}*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+#endif /* TONEMETER_H */
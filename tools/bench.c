@@ -0,0 +1,272 @@
+/**@file
+ * @brief   The benchmark application.
+ * @details The benchmark application measures the time per sample spent by the hot paths of the library:
+ *  - msin      -- \c msin_sq015 over all phases, with and without attenuation.
+ *  - plain     -- \c gen_render with the postprocessing disabled.
+ *  - slow      -- \c gen_render of a slow tone with the postprocessing disabled, which walks the table segments.
+ *  - pp        -- \c gen_render of a slow tone with the postprocessing enabled, which runs the lookaheads.
+ *  - tern      -- \c gen_render of a tone attenuated down to one LSB.
+ *  - bank      -- \c bank_render of 8 channels into F32 frames, per sample.
+ *  - ppbank    -- \c bank_render of 8 slow channels at the same level with the postprocessing enabled.
+ *  - ppcache   -- the same as ppbank, with the channels sharing a cache of the lookahead results, see \c ppcache.h.
+ *  - meter     -- \c tm_feed.
+ *
+ * @details Each case is run the given number of rounds, and the best round is reported, in nanoseconds per sample.
+ *  The checksum of the results is printed as well; it shall not change between builds of the same sources.
+ * @details Usage: bench [-r rounds] [-n samples] [-b baseline] [-t]
+ *  - rounds    -- number of rounds of each case; 5 by default.
+ *  - samples   -- number of samples of each round; 2^20 by default.
+ *  - baseline  -- file with the output of another build of the benchmark; the speedup against it is reported.
+ *  - -t        -- runs the training workload for the profile guided optimization instead of the benchmark.
+ *
+ * @details The training workload renders a pseudo-random mix of tones: slow and fast frequencies, attenuations from
+ *  none to one LSB, the postprocessing enabled and disabled, single generators and banks in all output formats. It
+ *  does not repeat the cases of the benchmark, so that the profile is not biased towards them.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "fixtrig.h"
+#include "genbank.h"
+#include "ppcache.h"
+#include "sampfmt.h"
+#include "sinegen.h"
+#include "tonemeter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Number of samples rendered by one call.
+ */
+#define BENCH_BLOCK     (0x1000)
+
+/**@brief   Number of channels of the bank case.
+ */
+#define BENCH_CHANS     (8)
+
+/**@brief   Number of entries of the cache of the lookahead results.
+ */
+#define BENCH_CACHE     (PPC_MAX_SIZE)
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for the state of a benchmark case.
+ */
+struct bench_t {
+    struct gen_descr_t  gens[BENCH_CHANS];      /**< Generators. */
+    struct bank_descr_t bank;                   /**< Bank of the generators. */
+    struct tm_descr_t   tm;                     /**< Tone meter. */
+    struct ppc_descr_t  cache;                  /**< Cache of the lookahead results. */
+    struct ppc_entry_t  ents[BENCH_CACHE];      /**< Entries of the cache. */
+    sq015_t buf[BENCH_BLOCK];                   /**< Output of a generator. */
+    float   frames[BENCH_BLOCK * BENCH_CHANS];  /**< Output of the bank. */
+    unsigned long   sum;                        /**< Checksum of the results. */
+};
+
+/**@brief   Type of a function running a benchmark case.
+ * @param[in,out]   pb  -- pointer to the state of the case.
+ * @param[in]       n   -- number of samples to process.
+ */
+typedef void (*bench_fn_t)(struct bench_t * const pb, const unsigned long n);
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+static void run_msin(struct bench_t * const pb, const unsigned long n) {
+
+    static const uq016_t atts[] = { 0x0000, 0x1234 };
+    unsigned long   idx;
+    ui16_t  phi = 0;
+
+    for (idx = 0; idx < n; ++idx, ++phi) {
+        pb->sum += (ui16_t)msin_sq015(phi, atts[idx >> 16 & 1]);
+    }
+}
+
+static void run_render(struct bench_t * const pb, const unsigned long n) {
+
+    unsigned long   idx;
+
+    for (idx = 0; idx < n; idx += BENCH_BLOCK) {
+        gen_render(&pb->gens[0], pb->buf, BENCH_BLOCK);
+        pb->sum += (ui16_t)pb->buf[idx / BENCH_BLOCK * 61 % BENCH_BLOCK];
+    }
+}
+
+static void run_bank(struct bench_t * const pb, const unsigned long n) {
+
+    unsigned long   idx;
+
+    for (idx = 0; idx < n; idx += BENCH_BLOCK * BENCH_CHANS) {
+        bank_render(&pb->bank, FMT_F32, pb->frames, BENCH_BLOCK);
+        pb->sum += (ui16_t)(si16_t)(pb->frames[idx / BENCH_BLOCK * 61 % (BENCH_BLOCK * BENCH_CHANS)] * 0x8000);
+    }
+}
+
+static void run_cache(struct bench_t * const pb, const unsigned long n) {
+
+    bank_set_cache(&pb->bank, &pb->cache);
+    run_bank(pb, n);
+}
+
+static void run_meter(struct bench_t * const pb, const unsigned long n) {
+
+    unsigned long   idx;
+    uq016_t amp, phi;
+
+    tm_init(&pb->tm, 0x0123);
+    for (idx = 0; idx < n; idx += BENCH_BLOCK) {
+        if (pb->tm.cnt > 0xFFFF - BENCH_BLOCK) {
+            tm_result(&pb->tm, &amp, &phi);
+            pb->sum += amp + phi;
+            tm_init(&pb->tm, 0x0123);
+        }
+        tm_feed(&pb->tm, pb->buf, BENCH_BLOCK);
+    }
+}
+
+static void run_train(struct bench_t * const pb, const unsigned long n) {
+
+    static const uq016_t atts[] = { 0x0000, 0x0010, 0x4000, 0x9000, 0xF000, 0xFF00, 0xFFF0, 0xFFFD, 0xFFFE, 0xFFFF };
+    unsigned long   seed = 1, idx;
+    uq016_t freq;
+    int     chan;
+
+    for (idx = 0; idx < n; idx += BENCH_BLOCK * BENCH_CHANS) {
+        for (chan = 0; chan < BENCH_CHANS; ++chan) {
+            seed = seed * 1103515245uL + 12345;
+            /* The frequency 1 is left out: its lookahead may exceed the domain of sqrt_ui16 and fail the assertion. */
+            freq = (uq016_t)((seed >> 10) % (seed >> 8 & 1 ? 0x3FFF : 64) + 2);
+            gen_set_freq(&pb->gens[chan], freq);
+            gen_set_phi(&pb->gens[chan], (uq016_t)(seed >> 12));
+            gen_set_att(&pb->gens[chan], atts[(seed >> 16) % ARRAY_SIZE(atts)]);
+            gen_set_pp(&pb->gens[chan], (bool_t)(seed >> 9 & 1));
+        }
+        if (seed >> 20 & 1) {
+            bank_render(&pb->bank, (ui8_t)((seed >> 21) % 5), pb->frames, BENCH_BLOCK);
+        } else {
+            for (chan = 0; chan < BENCH_CHANS; ++chan) {
+                gen_render(&pb->gens[chan], pb->buf, BENCH_BLOCK);
+            }
+        }
+        pb->sum += (ui16_t)pb->buf[seed % BENCH_BLOCK];
+    }
+}
+
+static double now_ns(void) {
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+int main(int argc, char * argv[]) {
+
+    static const struct {
+        const char * name;      /* Name of the case. */
+        bench_fn_t  fn;         /* Function running the case. */
+        uq016_t freq;           /* Frequency of the generators. */
+        uq016_t att;            /* Attenuation of the generators. */
+        bool_t  en;             /* Postprocessing status of the generators. */
+    } cases[] = {
+        { "msin", run_msin, 0, 0, 0 },
+        { "plain", run_render, 0x0123, 0x1000, 0 },
+        { "slow", run_render, 0x0004, 0x1000, 0 },
+        { "pp", run_render, 0x0003, 0xF000, 1 },
+        { "tern", run_render, 0x0123, 0xFFFE, 0 },
+        { "bank", run_bank, 0x0123, 0x1000, 1 },
+        { "ppbank", run_bank, 0x0002, 0xFF00, 1 },
+        { "ppcache", run_cache, 0x0002, 0xFF00, 1 },
+        { "meter", run_meter, 0x0123, 0x1000, 0 },
+    };
+    static struct bench_t   bench;  /* State of the benchmark. */
+    double  base[ARRAY_SIZE(cases)];    /* Baseline time of each case, in nanoseconds per sample; 0 if unknown. */
+    unsigned long   rounds = 5, n = 1uL << 20;
+    unsigned long   idx, round;
+    const char * pname = NULL;
+    int     opt, chan, train = 0;
+
+    while ((opt = getopt(argc, argv, "r:n:b:t")) != -1) {
+        switch (opt) {
+        case 'r': rounds = strtoul(optarg, NULL, 0); break;
+        case 'n': n = strtoul(optarg, NULL, 0); break;
+        case 'b': pname = optarg; break;
+        case 't': train = 1; break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc || rounds == 0 || n == 0) {
+        fprintf(stderr, "\nUsage: %s [-r rounds] [-n samples] [-b baseline] [-t]\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (train) {
+        bank_init(&bench.bank, bench.gens, BENCH_CHANS);
+        run_train(&bench, n * 16);
+        printf("training  sum %08lX\n", bench.sum & 0xFFFFFFFFuL);
+        return EXIT_SUCCESS;
+    }
+
+    memset(base, 0, sizeof(base));
+    if (pname != NULL) {
+        FILE *  pfile = fopen(pname, "r");      /* File with the baseline results. */
+        char    name[16];                       /* Name of a case. */
+        double  ns;                             /* Time of a case. */
+        if (pfile == NULL) {
+            fprintf(stderr, "\nERROR: Failed to open file: %s\n\n", pname);
+            return EXIT_FAILURE;
+        }
+        while (fscanf(pfile, "%15s %lf%*[^\n]", name, &ns) == 2) {
+            for (idx = 0; idx < ARRAY_SIZE(cases); ++idx) {
+                base[idx] = strcmp(name, cases[idx].name) == 0 ? ns : base[idx];
+            }
+        }
+        fclose(pfile);
+    }
+
+    ppc_init(&bench.cache, bench.ents, BENCH_CACHE, NULL, NULL, NULL);
+    for (idx = 0; idx < ARRAY_SIZE(cases); ++idx) {
+        double  best = 0;       /* Time of the best round, in nanoseconds. */
+
+        bank_init(&bench.bank, bench.gens, BENCH_CHANS);
+        for (chan = 0; chan < BENCH_CHANS; ++chan) {
+            gen_set_freq(&bench.gens[chan], (uq016_t)(cases[idx].freq + chan));
+            gen_set_att(&bench.gens[chan], cases[idx].att);
+            gen_set_pp(&bench.gens[chan], cases[idx].en);
+        }
+        gen_render(&bench.gens[0], bench.buf, BENCH_BLOCK);     /* The input of the meter. */
+        bench.sum = 0;
+
+        for (round = 0; round < rounds; ++round) {
+            double  t0 = now_ns(), t;
+            cases[idx].fn(&bench, n);
+            t = now_ns() - t0;
+            best = round == 0 || t < best ? t : best;
+        }
+        printf("%-8s %8.3f ns/sample  %8.2f Msamples/s  sum %08lX", cases[idx].name, best / n, n / best * 1e3,
+            bench.sum & 0xFFFFFFFFuL);
+        if (base[idx] > 0) {
+            printf("  speedup %5.2f", base[idx] * n / best);
+        }
+        printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,489 @@
+/**@file
+ * @brief   The capture comparison application.
+ * @details The capture comparison application finds where two captures of the generator output differ. Both files are
+ *  mapped into memory, so captures of any size are compared without reading them into buffers. The supported formats
+ *  of the files are:
+ *  - raw   -- interleaved frames as written by the capture application; the sample format and the number of channels
+ *              are given in the command line.
+ *  - WAV   -- RIFF WAVE files with 16, 24 or 32-bit integer, or 32-bit floating point samples; detected by the header.
+ *  - CSV   -- text files as written by the test application: the phase code, then a column per channel; detected by the
+ *              .csv extension. Text files are parsed into memory.
+ *
+ * @details When both files are binary and have the same layout, the first divergence is searched with \c memcmp over
+ *  large blocks, which compares many bytes per instruction, and samples are decoded only within differing blocks.
+ *  Otherwise the files are compared sample by sample, as SQ0.15 codes. The differences are reported in LSB of SQ0.15.
+ * @details If the configuration of the generators is given, the state of the generator of the first differing sample
+ *  is replayed up to that sample and printed along with its output, so the report tells which file is right and where
+ *  the generator was. The generators of binary files are laid out as by the capture application: the phase of the
+ *  channel number c is phi + c/chans of the period. The generators of CSV files are laid out as by the test
+ *  application: they have the same phase, and the postprocessing is enabled on the second one only.
+ * @details Usage: capdiff [-t type] [-c chans] [-f freq] [-p phi] [-a att] [-e pp] file1 file2
+ *  - type              -- format of samples of raw files: sq015, f32, s24, s32, ob16.
+ *  - chans             -- number of channels of raw files.
+ *  - freq, phi, att    -- codes of the generator attributes, decimal or hexadecimal with the 0x prefix.
+ *  - pp                -- 1 if the postprocessing is enabled, 0 otherwise.
+ *
+ * @details The status is 0 if the captures are identical, non-zero otherwise.
+ * @note    Binary samples are decoded in the byte order of the host, which shall be little endian for WAV files.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "sampfmt.h"
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define CAPDIFF_BLOCK   (0x10000uL)         /**< Size of a block compared with memcmp, in bytes. */
+#define CAPDIFF_CHANS   (64)                /**< Maximum number of channels. */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Names of output sample formats, indexed by FMT_xxx.
+ */
+static const char * const fmt_names[] = { "sq015", "f32", "s24", "s32", "ob16" };
+
+/**@brief   Names of capture file formats.
+ */
+static const char * const kind_names[] = { "raw", "WAV", "CSV" };
+
+/**@brief   Data structure for an opened capture.
+ */
+struct cap_t {
+    const ui8_t * pmap;                 /**< Mapping of the file; NULL if the file is empty. */
+    size_t  size;                       /**< Size of the file, then of the samples of a WAV file, in bytes. */
+    const ui8_t * pdata;                /**< Pointer to the first sample. */
+    sq015_t * pcsv;                     /**< Samples parsed from a CSV file; NULL for binary files. */
+    unsigned long   samples;            /**< Number of samples of all channels. */
+    ui8_t   type;                       /**< Format of samples, one of FMT_xxx. */
+    ui8_t   chans;                      /**< Number of channels. */
+    ui8_t   size1;                      /**< Size of a sample, in bytes. */
+    int     kind;                       /**< Format of the file: 0 for raw, 1 for WAV, 2 for CSV. */
+};
+
+/**@brief   Data structure for the statistics of the differences.
+ */
+struct stats_t {
+    unsigned long   first;              /**< Index of the first differing sample. */
+    unsigned long   cnt;                /**< Number of differing samples. */
+    unsigned long   chan[CAPDIFF_CHANS];    /**< Number of differing samples of each channel. */
+    unsigned long   imax;               /**< Index of the sample with the largest difference. */
+    double  max;                        /**< Largest absolute difference, in LSB. */
+    double  sum2;                       /**< Sum of squared differences. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@cond false*/
+static unsigned long get_le(const ui8_t * const p, const int n) {
+
+    unsigned long   x = 0;
+    int     idx;
+
+    for (idx = n - 1; idx >= 0; --idx) {
+        x = x << 8 | p[idx];
+    }
+    return x;
+}
+/**@endcond*/
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Finds the format and the samples of a WAV file.
+ * @param[in,out]   pcap    -- pointer to the capture of the mapped file.
+ * @return  The status: 0 if the file is a supported WAV file, non-zero otherwise.
+ */
+static int wav_parse(struct cap_t * const pcap) {
+
+    const ui8_t * p = pcap->pmap + 12;      /* Current chunk. */
+    const ui8_t * const pend = pcap->pmap + pcap->size;
+    unsigned long   len, fmt = 0, bits = 0;
+
+    while (pend - p >= 8) {
+        len = get_le(p + 4, 4);
+        if (memcmp(p, "fmt ", 4) == 0 && len >= 16 && (unsigned long)(pend - p - 8) >= len) {
+            fmt = get_le(p + 8, 2);
+            pcap->chans = (ui8_t)get_le(p + 10, 2);
+            bits = get_le(p + 22, 2);
+            if (fmt == 0xFFFE && len >= 26) {       /* WAVE_FORMAT_EXTENSIBLE: the format starts the GUID. */
+                fmt = get_le(p + 32, 2);
+            }
+        } else if (memcmp(p, "data", 4) == 0) {
+            pcap->pdata = p + 8;
+            pcap->size = (unsigned long)(pend - p - 8) < len ? (size_t)(pend - p - 8) : len;
+            break;
+        }
+        if ((unsigned long)(pend - p - 8) < len + (len & 1)) {
+            break;
+        }
+        p += 8 + len + (len & 1);
+    }
+    if (pcap->pdata == NULL || pcap->chans == 0) {
+        return -1;
+    }
+    if (fmt == 1 && bits == 16) {
+        pcap->type = FMT_SQ015;
+    } else if (fmt == 1 && bits == 24) {
+        pcap->type = FMT_S24;
+    } else if (fmt == 1 && bits == 32) {
+        pcap->type = FMT_S32;
+    } else if (fmt == 3 && bits == 32) {
+        pcap->type = FMT_F32;
+    } else {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Parses the samples of a CSV file.
+ * @param[in,out]   pcap    -- pointer to the capture of the mapped file.
+ * @return  The status: 0 if the file is parsed, non-zero otherwise.
+ * @details Each line holds the phase code and one sample code per channel, separated with semicolons. The number of
+ *  channels is taken from the first line.
+ */
+static int csv_parse(struct cap_t * const pcap) {
+
+    const char * p = (const char *)pcap->pmap;
+    const char * const pend = p + pcap->size;
+    unsigned long   size = 0;           /* Number of samples allocated. */
+    int     col;                        /* Index of the column within the line. */
+    int     neg;                        /* Equals to 1 if the number is negative. */
+    long    x;
+
+    pcap->chans = 0;
+    while (p < pend) {
+        for (col = 0; p < pend && *p != '\n'; ++col) {
+            neg = *p == '-';
+            p += neg;
+            if (p == pend || *p < '0' || *p > '9' || col > CAPDIFF_CHANS) {
+                return -1;
+            }
+            for (x = 0; p < pend && *p >= '0' && *p <= '9' && x <= 0xFFFF; ++p) {
+                x = x * 10 + (*p - '0');
+            }
+            x = neg ? -x : x;
+            if (x < -0x8000 || x > (col == 0 ? 0xFFFF : 0x7FFF)) {
+                return -1;
+            }
+            for (; p < pend && (*p == ';' || *p == ' ' || *p == '\r'); ++p) {
+            }
+            if (col == 0) {
+                continue;
+            }
+            if (pcap->samples == size) {
+                sq015_t * pn = realloc(pcap->pcsv, (size * 2 + 0x10000) * sizeof(sq015_t));
+                if (pn == NULL) {
+                    return -1;
+                }
+                pcap->pcsv = pn;
+                size = size * 2 + 0x10000;
+            }
+            pcap->pcsv[pcap->samples++] = (sq015_t)x;
+        }
+        if (pcap->chans == 0) {
+            pcap->chans = (ui8_t)(col - 1);
+        }
+        if (col != pcap->chans + 1 || col < 2) {
+            return -1;
+        }
+        ++p;
+    }
+    pcap->pdata = (const ui8_t *)pcap->pcsv;
+    pcap->type = FMT_SQ015;
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Opens a capture.
+ * @param[out]  pcap    -- pointer to the capture.
+ * @param[in]   name    -- name of the file.
+ * @param[in]   type    -- format of samples of a raw file.
+ * @param[in]   chans   -- number of channels of a raw file.
+ * @return  The status: 0 if the capture is opened, non-zero otherwise.
+ */
+static int cap_open(struct cap_t * const pcap, const char * const name, const ui8_t type, const ui8_t chans) {
+
+    struct stat st;
+    size_t  len = strlen(name);
+    int     fd, res;
+
+    memset(pcap, 0, sizeof(*pcap));
+    fd = open(name, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "\nERROR: Failed to open file: %s\n\n", name);
+        return -1;
+    }
+    if (fstat(fd, &st) != 0) {
+        fprintf(stderr, "\nERROR: Failed to open file: %s\n\n", name);
+        close(fd);
+        return -1;
+    }
+    pcap->size = (size_t)st.st_size;
+    if (pcap->size > 0) {
+        void *  p = mmap(NULL, pcap->size, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            fprintf(stderr, "\nERROR: Failed to map file: %s\n\n", name);
+            close(fd);
+            return -1;
+        }
+        pcap->pmap = p;
+        posix_madvise(p, pcap->size, POSIX_MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    pcap->pdata = pcap->pmap;
+    pcap->type = type;
+    pcap->chans = chans;
+    res = 0;
+    if (pcap->size >= 12 && memcmp(pcap->pmap, "RIFF", 4) == 0 && memcmp(pcap->pmap + 8, "WAVE", 4) == 0) {
+        pcap->kind = 1;
+        pcap->pdata = NULL;
+        res = wav_parse(pcap);
+    } else if (len > 4 && strcmp(name + len - 4, ".csv") == 0) {
+        pcap->kind = 2;
+        res = csv_parse(pcap);
+    }
+    if (res != 0 || pcap->chans == 0 || pcap->chans > CAPDIFF_CHANS) {
+        fprintf(stderr, "\nERROR: Unsupported %s file: %s\n\n", kind_names[pcap->kind], name);
+        return -1;
+    }
+    pcap->size1 = fmt_size(pcap->type);
+    if (pcap->kind != 2) {
+        pcap->samples = (unsigned long)(pcap->size / pcap->size1);
+    }
+
+    return 0;
+}
+
+/**@brief   Returns a sample of a capture, in LSB of SQ0.15.
+ * @param[in]   pcap    -- pointer to the capture.
+ * @param[in]   idx     -- index of the sample, counting the samples of all channels.
+ * @return  The value of the sample.
+ */
+static double cap_sample(const struct cap_t * const pcap, const unsigned long idx) {
+
+    const ui8_t * p = pcap->pdata + (size_t)idx * pcap->size1;
+    sq015_t x16;
+    si32_t  x32;
+    float   xf;
+    unsigned long   x;
+
+    switch (pcap->type) {
+    case FMT_F32:
+        memcpy(&xf, p, sizeof(xf));
+        return xf * 32768.0;
+    case FMT_S24:
+        x = get_le(p, 3);
+        return (x & 0x800000uL ? (double)x - 0x1000000L : (double)x) / 256.0;
+    case FMT_S32:
+        memcpy(&x32, p, sizeof(x32));
+        return x32 / 65536.0;
+    case FMT_OB16:
+        memcpy(&x16, p, sizeof(x16));
+        return (sq015_t)(x16 ^ 0x8000);
+    default:
+        memcpy(&x16, p, sizeof(x16));
+        return x16;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Compares a range of samples and accumulates the statistics of the differences.
+ * @param[in]       pa      -- pointer to the first capture.
+ * @param[in]       pb      -- pointer to the second capture.
+ * @param[in]       from    -- index of the first sample of the range.
+ * @param[in]       to      -- index of the sample after the range.
+ * @param[in,out]   pst     -- pointer to the statistics.
+ */
+static void diff_range(const struct cap_t * const pa, const struct cap_t * const pb, const unsigned long from,
+    const unsigned long to, struct stats_t * const pst) {
+
+    unsigned long   idx;
+    double  d;
+
+    for (idx = from; idx < to; ++idx) {
+        d = fabs(cap_sample(pa, idx) - cap_sample(pb, idx));
+        if (d != 0) {
+            pst->first = pst->cnt == 0 ? idx : pst->first;
+            ++(pst->cnt);
+            ++(pst->chan[idx % pa->chans]);
+            pst->sum2 += d * d;
+            if (d > pst->max) {
+                pst->max = d;
+                pst->imax = idx;
+            }
+        }
+    }
+}
+
+/**@brief   Compares two captures.
+ * @param[in]   pa      -- pointer to the first capture.
+ * @param[in]   pb      -- pointer to the second capture.
+ * @param[in]   n       -- number of samples to compare.
+ * @param[out]  pst     -- pointer to the statistics.
+ * @details If both captures are binary and have the same format, equal blocks are skipped with \c memcmp.
+ */
+static void diff(const struct cap_t * const pa, const struct cap_t * const pb, const unsigned long n,
+    struct stats_t * const pst) {
+
+    const unsigned long block = CAPDIFF_BLOCK / pa->size1;      /* Number of samples of a block. */
+    unsigned long   idx, end;
+
+    memset(pst, 0, sizeof(*pst));
+    if (pa->kind == 2 || pb->kind == 2 || pa->type != pb->type) {
+        diff_range(pa, pb, 0, n, pst);
+        return;
+    }
+    for (idx = 0; idx < n; idx = end) {
+        end = n - idx < block ? n : idx + block;
+        if (memcmp(pa->pdata + (size_t)idx * pa->size1, pb->pdata + (size_t)idx * pb->size1,
+                (size_t)(end - idx) * pa->size1) != 0) {
+            diff_range(pa, pb, idx, end, pst);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Propagates a generator for the given number of samples.
+ * @param[in,out]   pgen    -- pointer to a generator descriptor object.
+ * @param[in]       n       -- number of samples.
+ */
+static void skip(struct gen_descr_t * const pgen, unsigned long n) {
+
+    sq015_t buf[0x1000];
+    ui16_t  cnt;
+
+    for (; n > 0; n -= cnt) {
+        cnt = n < ARRAY_SIZE(buf) ? (ui16_t)n : (ui16_t)ARRAY_SIZE(buf);
+        gen_render(pgen, buf, cnt);
+    }
+}
+
+/**@brief   Replays a generator from the start up to the given sample.
+ * @param[in,out]   pgen    -- pointer to a configured generator descriptor object.
+ * @param[in]       n       -- index of the sample.
+ * @details After a restart the state of the generator repeats with the period of the phase once the first period is
+ *  over. So the generator is run for two periods, and if the state at their ends is the same, the rest is skipped by
+ *  whole periods. Otherwise, the generator is run all the way.
+ */
+static void replay(struct gen_descr_t * const pgen, unsigned long n) {
+
+    struct gen_descr_t  snap;       /* State at the end of the first period. */
+    unsigned long   period;         /* Period of the phase, in samples. */
+
+    if (pgen->freq != 0) {
+        period = 0x10000uL / (pgen->freq & -pgen->freq);
+        if (n >= 2 * period) {
+            skip(pgen, period);
+            snap = *pgen;
+            skip(pgen, period);
+            n -= 2 * period;
+            n = memcmp(&snap, pgen, sizeof(snap)) == 0 ? n % period : n;
+        }
+    }
+    skip(pgen, n);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if the captures are identical, non-zero otherwise.
+ */
+int main(int argc, char * argv[]) {
+
+    struct cap_t    caps[2];            /* Captures. */
+    struct stats_t  st;                 /* Statistics of the differences. */
+    struct gen_descr_t  gen;            /* Replayed generator. */
+    unsigned long   freq = 0x10000uL, phi = 0, att = 0, pp = 0, chans = 1, n, frame;
+    ui8_t   type = FMT_SQ015, chan;
+    int     opt, idx;
+
+    while ((opt = getopt(argc, argv, "t:c:f:p:a:e:")) != -1) {
+        switch (opt) {
+        case 'c': chans = strtoul(optarg, NULL, 0); break;
+        case 'f': freq = strtoul(optarg, NULL, 0); break;
+        case 'p': phi = strtoul(optarg, NULL, 0); break;
+        case 'a': att = strtoul(optarg, NULL, 0); break;
+        case 'e': pp = strtoul(optarg, NULL, 0); break;
+        case 't':
+            for (type = 0; type < ARRAY_SIZE(fmt_names) && strcmp(optarg, fmt_names[type]) != 0; ++type) {
+            }
+            break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc - 2 || type >= ARRAY_SIZE(fmt_names) || chans < 1 || chans > CAPDIFF_CHANS ||
+            (freq > 0x4000 && freq != 0x10000uL) || phi > 0xFFFF || att > 0xFFFF) {
+        fprintf(stderr, "\nUsage: %s [-t sq015|f32|s24|s32|ob16] [-c chans] [-f freq] [-p phi] [-a att] [-e pp] "
+            "file1 file2\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    for (idx = 0; idx < 2; ++idx) {
+        if (cap_open(&caps[idx], argv[optind + idx], type, (ui8_t)chans) != 0) {
+            return EXIT_FAILURE;
+        }
+        printf("file%d  %-3s %-5s %2u channels %12lu frames  %s\n", idx + 1, kind_names[caps[idx].kind],
+            fmt_names[caps[idx].type], (unsigned int)caps[idx].chans, caps[idx].samples / caps[idx].chans,
+            argv[optind + idx]);
+    }
+    if (caps[0].chans != caps[1].chans) {
+        fprintf(stderr, "\nERROR: Different numbers of channels\n\n");
+        return EXIT_FAILURE;
+    }
+
+    chans = caps[0].chans;
+    n = caps[0].samples < caps[1].samples ? caps[0].samples : caps[1].samples;
+    n -= n % chans;
+    diff(&caps[0], &caps[1], n, &st);
+    if (st.cnt == 0) {
+        printf("identical over %lu frames\n", n / chans);
+        return caps[0].samples == caps[1].samples ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    frame = st.first / chans;
+    chan = (ui8_t)(st.first % chans);
+    printf("first difference at frame %lu, channel %u: %.11g vs %.11g\n", frame, (unsigned int)chan,
+        cap_sample(&caps[0], st.first), cap_sample(&caps[1], st.first));
+    if (freq != 0x10000uL) {
+        memset(&gen, 0, sizeof(gen));
+        gen_init(&gen);
+        gen_set_freq(&gen, (uq016_t)freq);
+        if (caps[0].kind == 2) {
+            gen_set_phi(&gen, (uq016_t)phi);
+            gen_set_pp(&gen, chan != 0);
+        } else {
+            gen_set_phi(&gen, (uq016_t)(phi + 0x10000uL * chan / chans));
+            gen_set_pp(&gen, pp != 0);
+        }
+        gen_set_att(&gen, (uq016_t)att);
+        replay(&gen, frame);
+        printf("replay: output %d  phi %04X  tern %u  en %u  fail %u  phi0 %04X  phi1 %04X  phi2 %04X  sidx %u/%u\n",
+            (int)gen_output(&gen), (unsigned int)gen.phi, (unsigned int)gen.tern, (unsigned int)gen.en,
+            (unsigned int)gen.fail, (unsigned int)gen.phi0, (unsigned int)gen.phi1, (unsigned int)gen.phi2,
+            (unsigned int)gen.sidx, (unsigned int)gen.sampl);
+    }
+    printf("differences: %lu of %lu samples (%.6f%%), max %.11g LSB at frame %lu channel %lu, rms %.6g LSB\n",
+        st.cnt, n, 100.0 * st.cnt / n, st.max, st.imax / chans, st.imax % chans, sqrt(st.sum2 / n));
+    for (idx = 0; idx < (int)chans; ++idx) {
+        if (st.chan[idx] > 0) {
+            printf("  channel %2d: %lu\n", idx, st.chan[idx]);
+        }
+    }
+
+    return EXIT_FAILURE;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,242 @@
+/**@file
+ * @brief   The capture application.
+ * @details The capture application renders a long run of the output of a bank of sine wave generators into a binary
+ *  file of interleaved frames. All generators have the same frequency, attenuation and postprocessing status; their
+ *  initial phases are equally spaced over the period, starting with the given phase.
+ * @details Usage: capture [-f freq] [-p phi] [-a att] [-e pp] [-c chans] [-t type] [-n frames] [-b block] [-w sink]
+ *  [-s] [-r policy [-q slots]] file
+ *  - freq, phi, att    -- codes of the generator attributes, decimal or hexadecimal with the 0x prefix.
+ *  - pp                -- 1 to enable the postprocessing, 0 to disable it.
+ *  - chans             -- number of channels, from 1 to 64.
+ *  - type              -- format of samples: sq015, f32, s24, s32, ob16.
+ *  - frames            -- number of frames to capture.
+ *  - block             -- number of frames in a block.
+ *  - sink              -- backend of the capture sink: sync, uring (default), threads.
+ *  - -s                -- render, convert and write serially in a single thread instead of the pipeline.
+ *  - policy            -- render into a shared memory ring instead of a file: block, overwrite. The file is then the
+ *                         name of the ring, e.g. /tone; see \c shmring.h.
+ *  - slots             -- number of slots in the ring, each holding a block.
+ *
+ * @details Statistics of the capture are printed to the standard error stream.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "pipeline.h"
+#include "sampfmt.h"
+#include "shmring.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Names of output sample formats, indexed by FMT_xxx.
+ */
+static const char * const fmt_names[] = { "sq015", "f32", "s24", "s32", "ob16" };
+
+/**@brief   Names of capture sink backends, indexed by SINK_xxx.
+ */
+static const char * const sink_names[] = { "sync", "uring", "threads" };
+
+/**@brief   Names of ring policies, indexed by RING_xxx.
+ */
+static const char * const ring_names[] = { "block", "overwrite" };
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Prints statistics of a stage of the pipeline.
+ * @param[in]   name    -- name of the stage.
+ * @param[in]   pst     -- pointer to the stage statistics.
+ */
+static void print_stage(const char * const name, const struct pipe_stage_t * const pst) {
+    fprintf(stderr, "%-8s blocks %8lu  busy %8.3f s  stalls %8lu  in %8.3f s  out %8.3f s\n",
+        name, pst->blocks, pst->busy, pst->stalls, pst->stall_in, pst->stall_out);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Renders, converts and writes the frames serially.
+ * @param[in,out]   pbank   -- pointer to a bank descriptor object.
+ * @param[in]       type    -- format of output samples.
+ * @param[in,out]   psink   -- pointer to the capture sink.
+ * @param[in]       frames  -- number of frames to capture.
+ * @param[in]       block   -- number of frames in a block.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+static int run_serial(struct bank_descr_t * const pbank, const ui8_t type, struct sink_t * const psink,
+    unsigned long frames,
+    const ui16_t block) {
+
+    ui8_t * buf;        /* Buffer of frames. */
+    size_t  frame;      /* Size of a frame, in bytes. */
+
+    frame = (size_t)fmt_size(type) * pbank->chans;
+    buf = malloc(frame * block);
+    if (buf == NULL) {
+        return -1;
+    }
+    while (frames > 0) {
+        ui16_t  n = frames < block ? (ui16_t)frames : block;
+        bank_render(pbank, type, buf, n);
+        if (sink_write(psink, buf, n * frame) != 0) {
+            free(buf);
+            return -1;
+        }
+        frames -= n;
+    }
+    free(buf);
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Renders the frames into a shared memory ring.
+ * @param[in,out]   pbank   -- pointer to a bank descriptor object.
+ * @param[in]       pr      -- pointer to the writer of a ring.
+ * @param[in]       type    -- format of output samples.
+ * @param[in]       frames  -- number of frames to capture.
+ * @param[in]       block   -- number of frames in a block.
+ * @details Blocks are rendered directly into slots of the ring, so readers consume them without copies.
+ */
+static void run_ring(struct bank_descr_t * const pbank, struct ring_t * const pr, const ui8_t type,
+    unsigned long frames, const ui16_t block) {
+
+    while (frames > 0) {
+        ui16_t  n = frames < block ? (ui16_t)frames : block;
+        bank_render(pbank, type, ring_claim(pr), n);
+        ring_publish(pr, n);
+        frames -= n;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+int main(int argc, char * argv[]) {
+
+    static struct gen_descr_t   gens[BANK_MAX_CHANS];   /* Generators of the bank. */
+    struct bank_descr_t bank;                           /* Bank of generators. */
+    struct pipe_stats_t stats;                          /* Statistics of the pipelined capture. */
+    struct sink_stats_t sstats;                         /* Statistics of the capture sink. */
+    struct sink_t * psink;                              /* Capture sink. */
+    struct ring_info_t  info;                           /* Parameters of the shared memory ring. */
+    struct ring_stats_t rstats;                         /* Statistics of the shared memory ring. */
+    struct ring_t * pr;                                 /* Writer of the shared memory ring. */
+    unsigned long   freq = 4, phi = 0, att = 0xFFF8, pp = 1, chans = 1, frames = 1uL << 24, block = 4096;
+    ui8_t   type = FMT_SQ015;
+    int     backend = SINK_URING;
+    int     serial = 0;
+    int     policy = -1;
+    unsigned long   slots = 16;
+    int     opt, res;
+    ui8_t   chan;
+    struct timespec t0, t1;
+
+    while ((opt = getopt(argc, argv, "f:p:a:e:c:t:n:b:w:sr:q:")) != -1) {
+        switch (opt) {
+        case 'f': freq = strtoul(optarg, NULL, 0); break;
+        case 'p': phi = strtoul(optarg, NULL, 0); break;
+        case 'a': att = strtoul(optarg, NULL, 0); break;
+        case 'e': pp = strtoul(optarg, NULL, 0); break;
+        case 'c': chans = strtoul(optarg, NULL, 0); break;
+        case 'n': frames = strtoul(optarg, NULL, 0); break;
+        case 'b': block = strtoul(optarg, NULL, 0); break;
+        case 's': serial = 1; break;
+        case 'q': slots = strtoul(optarg, NULL, 0); break;
+        case 't':
+            for (type = 0; type < ARRAY_SIZE(fmt_names) && strcmp(optarg, fmt_names[type]) != 0; ++type) {
+            }
+            break;
+        case 'w':
+            for (backend = 0; backend < (int)ARRAY_SIZE(sink_names) && strcmp(optarg, sink_names[backend]) != 0;
+                    ++backend) {
+            }
+            break;
+        case 'r':
+            for (policy = 0; policy < (int)ARRAY_SIZE(ring_names) && strcmp(optarg, ring_names[policy]) != 0;
+                    ++policy) {
+            }
+            break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc - 1 || freq > 0x4000 || phi > 0xFFFF || att > 0xFFFF || chans < 1 || chans > BANK_MAX_CHANS ||
+            block < 1 || block > 0xFFFF || type >= ARRAY_SIZE(fmt_names) || backend >= (int)ARRAY_SIZE(sink_names) ||
+            policy >= (int)ARRAY_SIZE(ring_names) || slots < 2 || slots > 0xFFFF) {
+        fprintf(stderr, "\nUsage: %s [-f freq] [-p phi] [-a att] [-e pp] [-c chans] [-t sq015|f32|s24|s32|ob16] "
+            "[-n frames] [-b block] [-w sync|uring|threads] [-s] [-r block|overwrite [-q slots]] file\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bank_init(&bank, gens, (ui8_t)chans);
+    for (chan = 0; chan < chans; ++chan) {
+        gen_set_freq(&gens[chan], (uq016_t)freq);
+        gen_set_phi(&gens[chan], (uq016_t)(phi + 0x10000uL * chan / chans));
+        gen_set_att(&gens[chan], (uq016_t)att);
+        gen_set_pp(&gens[chan], pp != 0);
+    }
+
+    if (policy >= 0) {
+        info.type = type;
+        info.chans = (ui8_t)chans;
+        info.block = (ui16_t)block;
+        info.slots = (ui16_t)slots;
+        info.policy = (ui8_t)policy;
+        pr = ring_create(argv[optind], &info);
+        if (pr == NULL) {
+            fprintf(stderr, "\nERROR: Failed to create ring: %s: %s\n\n", argv[optind], strerror(errno));
+            return EXIT_FAILURE;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        run_ring(&bank, pr, type, frames, (ui16_t)block);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ring_destroy(pr, &rstats);
+        fprintf(stderr, "%lu frames in %.3f s\n", frames, (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9);
+        fprintf(stderr, "ring     %s  blocks %8lu  waits %8lu  wait %8.3f s\n", ring_names[policy], rstats.blocks,
+            rstats.waits, rstats.wait);
+        return EXIT_SUCCESS;
+    }
+
+    psink = sink_open(argv[optind], backend);
+    if (psink == NULL) {
+        fprintf(stderr, "\nERROR: Failed to create file: %s\n\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (serial) {
+        res = run_serial(&bank, type, psink, frames, (ui16_t)block);
+    } else {
+        res = pipe_capture(&bank, type, psink, frames, (ui16_t)block, &stats);
+    }
+    res |= sink_close(psink, &sstats);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    if (res != 0) {
+        fprintf(stderr, "\nERROR: Failed to write file: %s: %s\n\n", argv[optind], strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "%lu frames in %.3f s\n", frames, (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9);
+    if (serial == 0) {
+        print_stage("render", &stats.render);
+        print_stage("convert", &stats.convert);
+        print_stage("write", &stats.write);
+    }
+    fprintf(stderr, "sink     %s%s  chunks %8lu  waits %8lu  wait %8.3f s\n", sink_names[sstats.backend],
+        sstats.direct ? " (O_DIRECT)" : "", sstats.chunks, sstats.waits, sstats.wait);
+
+    return EXIT_SUCCESS;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,223 @@
+/**@file
+ * @brief   The backend comparison application.
+ * @details The backend comparison application renders the same tones with all backends of the C++ generator of
+ *  \c sinegen.hpp and compares them with the C reference \c gen_render:
+ *  - bit-exact backends shall reproduce the reference output and state sample by sample, with and without the
+ *      postprocessing;
+ *  - other backends are rendered without the postprocessing, and their maximum deviation from the reference is
+ *      reported, in LSB of SQ0.15; it shall not exceed the bound given for the backend in \c sinegen.hpp.
+ *
+ * @details The render time per sample is reported for each backend as well. Then the phase-to-sine table built at
+ *  compile time is compared with the table of the C library, and generators of tones fixed at compile time are
+ *  compared with the reference over three periods of the phase.
+ * @details Usage: gencmp [-n samples]
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#include "sinegen.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Tones rendered by the comparison: freq, phi, att.
+ */
+static const uq016_t tones[][3] = {
+    { 1, 0, 0 }, { 4, 0x1234, 0xFFF8 }, { 7, 0x8000, 0x8000 }, { 100, 0, 0x0100 }, { 1000, 0x4000, 0 },
+    { 0x2345, 0x0F00, 0x7777 }, { 0x4000, 0x0001, 0 }, { 3, 0xC000, 0xFFFE }, { 5, 0, 0xFFFF }, { 0, 0x4000, 0x1000 },
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Renders a tone with the C reference.
+ * @param[in]   tone    -- tone: freq, phi, att.
+ * @param[in]   pp      -- postprocessing status.
+ * @param[out]  out     -- rendered samples.
+ * @param[out]  pgen    -- pointer to the descriptor receiving the final state.
+ */
+static void render_c(const uq016_t * const tone, const bool pp, std::vector<sq015_t> &out,
+    struct gen_descr_t * const pgen) {
+
+    std::size_t done = 0;
+
+    std::memset(pgen, 0, sizeof(*pgen));
+    gen_init(pgen);
+    gen_set_freq(pgen, tone[0]);
+    gen_set_phi(pgen, tone[1]);
+    gen_set_att(pgen, tone[2]);
+    gen_set_pp(pgen, pp);
+    while (done < out.size()) {
+        const ui16_t n = out.size() - done < 0x8000 ? (ui16_t)(out.size() - done) : 0x8000;
+        gen_render(pgen, &out[done], n);
+        done += n;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Renders a tone with a C++ generator and compares it with the reference.
+ * @tparam  Gen     -- type of the generator.
+ * @param[in]   name    -- name of the generator.
+ * @param[in]   tone    -- tone: freq, phi, att.
+ * @param[in]   pp      -- postprocessing status.
+ * @param[in]   ref     -- reference samples.
+ * @param[in]   pref    -- pointer to the reference final state.
+ * @param[out]  pns     -- pointer to the variable accumulating the render time, in nanoseconds.
+ * @return  The maximum deviation, in LSB; -1 if the final state of a bit-exact generator differs.
+ */
+template <class Gen>
+static long compare(const uq016_t * const tone, const bool pp, const std::vector<sq015_t> &ref,
+    const struct gen_descr_t * const pref, double * const pns) {
+
+    constexpr unsigned shift = sizeof(typename Gen::phase_type) * 8 - 16;
+    std::vector<sq015_t> out(ref.size());
+    Gen gen;
+    long dev = 0;
+
+    gen.set_freq(typename Gen::phase_type(tone[0]) << shift);
+    gen.set_phi(typename Gen::phase_type(tone[1]) << shift);
+    gen.set_att(tone[2]);
+    if constexpr (requires { gen.set_pp(pp); }) {
+        gen.set_pp(pp);
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    gen.render(out);
+    *pns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+    for (std::size_t idx = 0; idx < ref.size(); ++idx) {
+        const long diff = std::labs((long)out[idx] - ref[idx]);
+        dev = diff > dev ? diff : dev;
+    }
+    if constexpr (requires { gen.descr(); }) {
+        const gen_descr_t &d = gen.descr();
+        if (d.phi != pref->phi || d.sidx != pref->sidx || d.pp != pref->pp || d.fail != pref->fail ||
+                d.phi0 != pref->phi0) {
+            return -1;
+        }
+    }
+
+    return dev;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Compares a C++ generator with the reference on all tones and prints the result.
+ * @tparam  Gen     -- type of the generator.
+ * @param[in]   name    -- name of the generator.
+ * @param[in]   pp      -- postprocessing status.
+ * @param[in]   n       -- number of samples per tone.
+ * @param[in]   bound   -- maximum deviation allowed, in LSB; 0 for bit-exact generators.
+ * @return  The status: 0 if the generator stays within the bound, non-zero otherwise.
+ */
+template <class Gen>
+static int report(const char * const name, const bool pp, const std::size_t n, const long bound) {
+
+    std::vector<sq015_t> ref(n);
+    struct gen_descr_t rgen;
+    double ns = 0, rns = 0;
+    long dev = 0;
+
+    for (const auto &tone : tones) {
+        const auto t0 = std::chrono::steady_clock::now();
+        render_c(tone, pp, ref, &rgen);
+        rns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        const long res = compare<Gen>(tone, pp, ref, &rgen, &ns);
+        dev = res < 0 || dev < 0 ? -1 : res > dev ? res : dev;
+    }
+    std::printf("%-28s pp %d  %8.2f ns/sample (C %6.2f)  ", name, pp, ns / n / ARRAY_SIZE(tones),
+        rns / n / ARRAY_SIZE(tones));
+    if (dev < 0) {
+        std::printf("STATE MISMATCH\n");
+    } else {
+        std::printf("max deviation %ld LSB%s\n", dev, dev > bound ? ", EXCEEDS THE BOUND" : "");
+    }
+
+    return dev < 0 || dev > bound;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Compares a generator of a tone fixed at compile time with the reference and prints the result.
+ * @tparam  Freq    -- frequency.
+ * @tparam  Att     -- attenuation.
+ * @tparam  Phi     -- initial phase.
+ * @return  The status: 0 if the generator matches the reference, non-zero otherwise.
+ */
+template <uq016_t Freq, uq016_t Att, uq016_t Phi>
+static int report_fixed() {
+
+    static const uq016_t tone[3] = { Freq, Phi, Att };
+    std::vector<sq015_t> ref(3 * sinegen::FixedTone<Freq, Att, Phi>::period), out(ref.size());
+    sinegen::FixedTone<Freq, Att, Phi> gen;
+    struct gen_descr_t rgen;
+    std::size_t idx, done;
+
+    render_c(tone, true, ref, &rgen);
+    for (done = 0, idx = 0; done < out.size(); done += idx % 7 + 1, ++idx) {      /* Blocks of varying size. */
+        gen.render(std::span<sq015_t>(out).subspan(done, std::min(idx % 7 + 1, out.size() - done)));
+    }
+    for (idx = 0; idx < ref.size() && out[idx] == ref[idx]; ++idx) {
+    }
+    std::printf("FixedTone<0x%04X,0x%04X,0x%04X>  period %6zu  ", Freq, Att, Phi, ref.size() / 3);
+    if (idx < ref.size()) {
+        std::printf("MISMATCH at sample %zu\n", idx);
+        return 1;
+    }
+    std::printf("match\n");
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if the backends stay within their bounds, non-zero otherwise.
+ */
+int main(int argc, char * argv[]) {
+
+    using namespace sinegen;
+    std::size_t n = 200000;
+    int opt, res = 0;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+        case 'n': n = std::strtoul(optarg, NULL, 0); break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* The bounds are the deviations stated in sinegen.hpp. */
+    res |= report<SineGen<backend::Reference>>("Reference<16,22>", false, n, 0);
+    res |= report<SineGen<backend::Reference>>("Reference<16,22>", true, n, 0);
+    res |= report<SineGen<backend::Lut>>("Lut<16,22>", false, n, 0);
+    res |= report<SineGen<backend::Lut>>("Lut<16,22>", true, n, 0);
+    res |= report<SineGen<backend::Cordic, 16, 22>>("Cordic<16,22>", false, n, 2);
+    res |= report<SineGen<backend::Cordic, 32, 30>>("Cordic<32,30>", false, n, 2);
+    res |= report<SineGen<backend::Poly, 16, 22>>("Poly<16,22>", false, n, 1);
+    res |= report<SineGen<backend::Poly, 32, 30>>("Poly<32,30>", false, n, 2);
+    res |= report<SineGen<backend::Recursive, 16, 22>>("Recursive<16,22>", false, n, 50);
+    res |= report<SineGen<backend::Recursive, 32, 30>>("Recursive<32,30>", false, n, 2);
+
+    if (std::memcmp(sinegen::qsin_table.data(), qsin_lut, sizeof(sinegen::qsin_table)) != 0) {
+        std::printf("qsin_table                   MISMATCH\n");
+        res = 1;
+    } else {
+        std::printf("qsin_table                   match\n");
+    }
+    res |= report_fixed<0x0400, 0xFFF0, 0x1234>();
+    res |= report_fixed<0x0100, 0x7777, 0x0000>();
+    res |= report_fixed<0x1000, 0x0000, 0x4000>();
+    res |= report_fixed<0x0040, 0xFFFE, 0x4000>();
+    res |= report_fixed<0x0800, 0xFFFE, 0xC000>();
+    res |= report_fixed<0x0008, 0xE000, 0x8001>();
+
+    return res ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,455 @@
+/**@file
+ * @brief   The golden regression application.
+ * @details The golden regression application renders a catalogue of generator configurations and checks that the
+ *  output is bit-exact with a manifest of reference hashes. Each configuration is rendered with \c gen_render from a
+ *  fresh generator over two periods of the phase: the output after a restart settles within one period, and repeats
+ *  with the period from then on, so the two periods cover every sample the configuration can produce. A paused
+ *  generator is rendered over GOLDEN_PAUSED samples.
+ * @details The samples of each configuration are folded into a streaming 64-bit hash while they are rendered, so no
+ *  output is stored. The hash is FNV-1a over the 16-bit container codes of the samples, computed with 32-bit halves
+ *  to stay within C90.
+ * @details Usage: golden [-j threads] [-c entries] [-t table] [-s shard] [-w] manifest
+ *  - threads   -- number of rendering threads; the number of online processors by default.
+ *  - entries   -- renders with a cache of the lookahead results of the given size, a power of 2, shared by all the
+ *      threads, and prints its statistics; see \c ppcache.h. No cache by default.
+ *  - table     -- renders with the schedule table written by \c ppsched -b attached to every generator, so the tones
+ *      of its plan replay their schedules; see \c ppsched.h. No table by default.
+ *  - shard     -- shard of the configurations in the form k/N, see \c shard.h; all configurations by default.
+ *  - -w        -- writes the manifest for the built-in catalogue instead of checking it.
+ *  - manifest  -- file of the manifest, e.g. output/golden.txt.
+ *
+ * @details The manifest is a text file. Lines starting with # are comments; every other line describes a configuration
+ *  with hexadecimal fields: freq, phi, att, pp, the number of samples and the hash. The configurations to check are
+ *  taken from the manifest, so an older manifest stays usable when the catalogue grows. Mismatches are printed to the
+ *  standard output stream, and the status is non-zero if there is any.
+ * @details A shard renders every N-th configuration only. Written with -w, the manifest of a shard is a partial result
+ *  file described by its first line, and the manifests of all shards are merged with \c shardmerge into the same file
+ *  as the unsharded run writes.
+ * @details The replay of a schedule is bit-exact with the lookahead, so a manifest of the tones of a plan, taken from
+ *  the golden manifest, checks the replay. Built with GEN_NO_LOOKAHEAD defined, the application checks the replay only:
+ *  the configurations which are not in the table are rendered with the postprocessing disabled, and mismatch.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "ppcache.h"
+#include "ppsched.h"
+#include "shard.h"
+#include "sinegen.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define GOLDEN_BLOCK    (0x1000)            /**< Number of samples rendered by one call. */
+#define GOLDEN_PAUSED   (0x1000)            /**< Number of samples rendered for a paused generator. */
+#define GOLDEN_THREADS  (64)                /**< Maximum number of rendering threads. */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a 64-bit hash, held in 32-bit halves.
+ */
+struct hash_t {
+    unsigned long   hi;                 /**< Upper 32 bits. */
+    unsigned long   lo;                 /**< Lower 32 bits. */
+};
+
+/**@brief   Data structure for a configuration of the catalogue.
+ */
+struct golden_t {
+    uq016_t freq;                       /**< Frequency code. */
+    uq016_t phi;                        /**< Initial phase code. */
+    uq016_t att;                        /**< Attenuation code. */
+    bool_t  pp;                         /**< Postprocessing status. */
+    unsigned long   n;                  /**< Number of samples. */
+    struct hash_t   ref;                /**< Reference hash, from the manifest. */
+    struct hash_t   hash;               /**< Hash of the rendered samples. */
+};
+
+/**@brief   Data structure for the work shared by the rendering threads.
+ */
+struct work_t {
+    pthread_mutex_t lock;               /**< Lock protecting the index of the next configuration. */
+    struct golden_t * pcfgs;            /**< Configurations. */
+    size_t  cnt;                        /**< Number of configurations. */
+    size_t  next;                       /**< Index of the next configuration to render. */
+    pthread_mutex_t cache_lock;         /**< Lock protecting the cache. */
+    struct ppc_descr_t *pcache;         /**< Cache of the lookahead results; NULL if none. */
+    const ui16_t *ptab;                 /**< Table of the postprocessing schedules; NULL if none. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Initializes a hash.
+ * @param[out]  ph  -- pointer to the hash.
+ */
+static void hash_init(struct hash_t * const ph) {
+    ph->hi = 0xCBF29CE4uL;              /* The offset basis of FNV-1a, 0xCBF29CE484222325. */
+    ph->lo = 0x84222325uL;
+}
+
+/**@brief   Folds a block of samples into a hash.
+ * @param[in,out]   ph  -- pointer to the hash.
+ * @param[in]       px  -- pointer to the samples.
+ * @param[in]       n   -- number of samples.
+ * @details The FNV prime 0x100000001B3 is 2^40 + 0x1B3, so the product is split into the product of the halves by
+ *  0x1B3, and the lower half shifted by 40 bits. The lower half is multiplied in 16-bit parts, so no product exceeds
+ *  32 bits.
+ */
+static void hash_feed(struct hash_t * const ph, const sq015_t * const px, const ui16_t n) {
+
+    unsigned long   hi = ph->hi, lo = ph->lo;
+    unsigned long   a, b;           /* Products of the lower and the upper 16 bits of the lower half by 0x1B3. */
+    ui16_t  idx;
+
+    for (idx = 0; idx < n; ++idx) {
+        lo ^= (ui16_t)px[idx];
+        a = (lo & 0xFFFFu) * 0x1B3u;
+        b = (lo >> 16) * 0x1B3u;
+        hi = (hi * 0x1B3u + (((a >> 16) + b) >> 16) + (lo << 8)) & 0xFFFFFFFFuL;
+        lo = (a + (b << 16)) & 0xFFFFFFFFuL;
+    }
+    ph->hi = hi;
+    ph->lo = lo;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Builds the built-in catalogue.
+ * @param[out]  pcfgs   -- pointer to the array receiving the configurations; NULL to count them only.
+ * @return  The number of configurations.
+ * @details The catalogue is the product of the frequencies, phases, attenuations and postprocessing statuses below:
+ *  slow and fast, odd and even frequencies, phases at and around the quadrant boundaries, and attenuations from none
+ *  down to the ternary and the silent outputs.
+ * @note    The frequency 1 is rendered without the postprocessing only: its lookahead may exceed the domain of
+ *  \c sqrt_ui16, which is a known limitation of the library.
+ */
+static size_t catalogue(struct golden_t * const pcfgs) {
+
+    static const uq016_t freqs[] = {
+        0x0000, 0x0001, 0x0002, 0x0003, 0x0004, 0x0005, 0x0007, 0x0008, 0x000C, 0x0010, 0x001F, 0x0040, 0x0064,
+        0x0123, 0x0400, 0x0555, 0x1000, 0x1234, 0x2345, 0x3000, 0x3FFF, 0x4000,
+    };
+    static const uq016_t phis[] = { 0x0000, 0x0001, 0x1234, 0x4000, 0x7FFF, 0x8000, 0xC000, 0xFFFF };
+    static const uq016_t atts[] = { 0x0000, 0x0001, 0x1000, 0x4000, 0x8000, 0xC000, 0xF000, 0xFFF8, 0xFFFE, 0xFFFF };
+    size_t  f, p, a, cnt = 0;
+    int     pp;
+
+    for (f = 0; f < ARRAY_SIZE(freqs); ++f) {
+        for (p = 0; p < ARRAY_SIZE(phis); ++p) {
+            for (a = 0; a < ARRAY_SIZE(atts); ++a) {
+                for (pp = 0; pp <= (freqs[f] != 1); ++pp, ++cnt) {
+                    if (pcfgs != NULL) {
+                        memset(&pcfgs[cnt], 0, sizeof(pcfgs[cnt]));
+                        pcfgs[cnt].freq = freqs[f];
+                        pcfgs[cnt].phi = phis[p];
+                        pcfgs[cnt].att = atts[a];
+                        pcfgs[cnt].pp = (bool_t)pp;
+                        pcfgs[cnt].n = freqs[f] == 0 ? GOLDEN_PAUSED : 0x20000uL / (freqs[f] & -freqs[f]);
+                    }
+                }
+            }
+        }
+    }
+
+    return cnt;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Locks the cache shared by the rendering threads.
+ * @param[in,out]   pctx    -- pointer to the mutex of the cache.
+ */
+static void cache_lock(void * const pctx) {
+
+    pthread_mutex_lock(pctx);
+}
+
+/**@brief   Unlocks the cache shared by the rendering threads.
+ * @param[in,out]   pctx    -- pointer to the mutex of the cache.
+ */
+static void cache_unlock(void * const pctx) {
+
+    pthread_mutex_unlock(pctx);
+}
+
+/**@brief   Renders a configuration and computes the hash of its output.
+ * @param[in,out]   pcfg    -- pointer to the configuration.
+ * @param[in,out]   pc      -- pointer to the cache of the lookahead results; NULL if none.
+ * @param[in]       ptab    -- pointer to the table of the postprocessing schedules; NULL if none.
+ */
+static void render(struct golden_t * const pcfg, struct ppc_descr_t * const pc, const ui16_t * const ptab) {
+
+    struct gen_descr_t  gen;            /* Generator. */
+    sq015_t buf[GOLDEN_BLOCK];          /* Block of samples. */
+    unsigned long   done;               /* Number of samples rendered. */
+    ui16_t  n;                          /* Number of samples in the block. */
+
+    memset(&gen, 0, sizeof(gen));
+    gen_init(&gen);
+    gen_set_cache(&gen, pc);
+    gen_set_sched(&gen, ptab);
+    gen_set_freq(&gen, pcfg->freq);
+    gen_set_phi(&gen, pcfg->phi);
+    gen_set_att(&gen, pcfg->att);
+    gen_set_pp(&gen, pcfg->pp);
+    hash_init(&pcfg->hash);
+    for (done = 0; done < pcfg->n; done += n) {
+        n = pcfg->n - done < GOLDEN_BLOCK ? (ui16_t)(pcfg->n - done) : GOLDEN_BLOCK;
+        gen_render(&gen, buf, n);
+        hash_feed(&pcfg->hash, buf, n);
+    }
+}
+
+/**@brief   Renders configurations until there are none left.
+ * @param[in,out]   arg     -- pointer to the shared work.
+ * @return  NULL.
+ */
+static void * worker(void * arg) {
+
+    struct work_t * pw = arg;
+    size_t  idx;
+
+    for (;;) {
+        pthread_mutex_lock(&pw->lock);
+        idx = pw->next < pw->cnt ? pw->next++ : pw->cnt;
+        pthread_mutex_unlock(&pw->lock);
+        if (idx == pw->cnt) {
+            return NULL;
+        }
+        render(&pw->pcfgs[idx], pw->pcache, pw->ptab);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Reads the configurations of a manifest.
+ * @param[in]   pfile   -- manifest file.
+ * @param[out]  pcnt    -- pointer to the variable receiving the number of configurations.
+ * @return  The allocated array of the configurations; NULL if there was a failure.
+ */
+static struct golden_t * read_manifest(FILE * const pfile, size_t * const pcnt) {
+
+    struct golden_t * pcfgs = NULL;     /* Configurations. */
+    size_t  size = 0;                   /* Number of configurations allocated. */
+    char    line[128];                  /* Line of the manifest. */
+    unsigned long   freq, phi, att, pp, n;
+    char    hash[17];                   /* Hash, in hexadecimal. */
+
+    *pcnt = 0;
+    while (fgets(line, sizeof(line), pfile) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        if (sscanf(line, "%lx %lx %lx %lx %lx %16[0-9A-Fa-f]", &freq, &phi, &att, &pp, &n, hash) != 6 ||
+                strlen(hash) != 16) {
+            fprintf(stderr, "\nERROR: Invalid line of manifest: %s\n", line);
+            free(pcfgs);
+            return NULL;
+        }
+        if (*pcnt == size) {
+            struct golden_t * p = realloc(pcfgs, (size * 2 + 256) * sizeof(*pcfgs));
+            if (p == NULL) {
+                free(pcfgs);
+                return NULL;
+            }
+            pcfgs = p;
+            size = size * 2 + 256;
+        }
+        memset(&pcfgs[*pcnt], 0, sizeof(pcfgs[*pcnt]));
+        pcfgs[*pcnt].freq = (uq016_t)freq;
+        pcfgs[*pcnt].phi = (uq016_t)phi;
+        pcfgs[*pcnt].att = (uq016_t)att;
+        pcfgs[*pcnt].pp = (bool_t)(pp != 0);
+        pcfgs[*pcnt].n = n;
+        pcfgs[*pcnt].ref.lo = strtoul(hash + 8, NULL, 16);
+        hash[8] = '\0';
+        pcfgs[*pcnt].ref.hi = strtoul(hash, NULL, 16);
+        ++(*pcnt);
+    }
+
+    return pcfgs;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Reads a schedule table written by ppsched -b.
+ * @param[in]   name    -- name of the file of the table.
+ * @return  The allocated table; NULL if there was a failure, which is reported.
+ */
+static ui16_t * read_table(const char * const name) {
+
+    ui16_t *ptab = NULL;                /* Table. */
+    ui32_t  size = 0;                   /* Number of words read. */
+    ui32_t  cap = 0;                    /* Number of words allocated. */
+    FILE *  pfile = fopen(name, "rb");
+    int     lo, hi;                     /* Bytes of a word. */
+
+    if (pfile == NULL) {
+        fprintf(stderr, "\nERROR: Failed to open file: %s\n\n", name);
+        return NULL;
+    }
+    while ((lo = fgetc(pfile)) != EOF && (hi = fgetc(pfile)) != EOF) {
+        if (size == cap) {
+            ui16_t *p = realloc(ptab, (cap * 2 + 0x1000) * sizeof(*ptab));
+            if (p == NULL) {
+                break;
+            }
+            ptab = p;
+            cap = cap * 2 + 0x1000;
+        }
+        ptab[size++] = (ui16_t)(lo | hi << 8);
+    }
+    if (lo != EOF || ferror(pfile) || size == 0 || sched_check(ptab, size) != 0) {
+        fprintf(stderr, "\nERROR: Invalid schedule table: %s\n\n", name);
+        free(ptab);
+        ptab = NULL;
+    }
+    fclose(pfile);
+
+    return ptab;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if all configurations match the manifest, non-zero otherwise.
+ */
+int main(int argc, char * argv[]) {
+
+    static pthread_t    thr[GOLDEN_THREADS];    /* Rendering threads. */
+    struct work_t   work;                       /* Shared work. */
+    struct timespec t0, t1;                     /* Start and end time of the rendering. */
+    struct shard_t  shard;                      /* Shard of the configurations. */
+    struct ppc_descr_t  cache;                  /* Cache of the lookahead results. */
+    struct ppc_entry_t *pents = NULL;           /* Entries of the cache. */
+    ui16_t *ptab = NULL;                        /* Table of the postprocessing schedules. */
+    const char * table = NULL;                  /* File of the table. */
+    unsigned long   entries = 0, hits, misses, evicts;
+    FILE *  pfile;                              /* Manifest file. */
+    unsigned long   threads = (unsigned long)sysconf(_SC_NPROCESSORS_ONLN), samples = 0, bad = 0;
+    size_t  idx;
+    int     opt, update = 0, err = 0;
+
+    memset(&shard, 0, sizeof(shard));
+    strcpy(shard.job, "golden");
+    shard.n = 1;
+    while ((opt = getopt(argc, argv, "j:c:t:s:w")) != -1) {
+        switch (opt) {
+        case 'j': threads = strtoul(optarg, NULL, 0); break;
+        case 'c': entries = strtoul(optarg, NULL, 0); break;
+        case 't': table = optarg; break;
+        case 's': err = shard_parse(optarg, &shard); break;
+        case 'w': update = 1; break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind + 1 != argc || threads == 0 || threads > GOLDEN_THREADS || err != 0 || entries > PPC_MAX_SIZE ||
+            (entries & (entries - 1)) != 0) {
+        fprintf(stderr, "\nUsage: %s [-j threads] [-c entries] [-t table] [-s k/N] [-w] manifest\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (table != NULL) {
+        ptab = read_table(table);
+        if (ptab == NULL) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    memset(&work, 0, sizeof(work));
+    if (update) {
+        work.cnt = catalogue(NULL);
+        work.pcfgs = malloc(work.cnt * sizeof(*work.pcfgs));
+        if (work.pcfgs != NULL) {
+            catalogue(work.pcfgs);
+        }
+    } else {
+        pfile = fopen(argv[optind], "r");
+        if (pfile == NULL) {
+            fprintf(stderr, "\nERROR: Failed to open file: %s\n\n", argv[optind]);
+            return EXIT_FAILURE;
+        }
+        work.pcfgs = read_manifest(pfile, &work.cnt);
+        fclose(pfile);
+    }
+    if (work.pcfgs == NULL) {
+        fprintf(stderr, "\nERROR: Failed to load the configurations\n\n");
+        return EXIT_FAILURE;
+    }
+    shard.total = work.cnt;
+    work.cnt = shard_items(&shard);
+    for (idx = 0; idx < work.cnt; ++idx) {
+        work.pcfgs[idx] = work.pcfgs[idx * shard.n + shard.k];
+    }
+
+    pthread_mutex_init(&work.cache_lock, NULL);
+    if (entries > 0) {
+        pents = malloc(entries * sizeof(*pents));
+        if (pents == NULL) {
+            fprintf(stderr, "\nERROR: Failed to allocate the cache\n\n");
+            return EXIT_FAILURE;
+        }
+        ppc_init(&cache, pents, (ui16_t)entries, cache_lock, cache_unlock, &work.cache_lock);
+        work.pcache = &cache;
+    }
+    work.ptab = ptab;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pthread_mutex_init(&work.lock, NULL);
+    for (idx = 0; idx + 1 < threads && err == 0; ++idx) {
+        err = pthread_create(&thr[idx], NULL, worker, &work);
+    }
+    threads = err == 0 ? idx : idx - 1;
+    worker(&work);                              /* The main thread is one of the rendering threads. */
+    for (idx = 0; idx < threads; ++idx) {
+        pthread_join(thr[idx], NULL);
+    }
+    pthread_mutex_destroy(&work.lock);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    if (update) {
+        pfile = fopen(argv[optind], "w");
+        if (pfile == NULL) {
+            fprintf(stderr, "\nERROR: Failed to create file: %s\n\n", argv[optind]);
+            return EXIT_FAILURE;
+        }
+        shard_write(pfile, &shard);
+        fprintf(pfile, "# Golden hashes of the generator output, see tools/golden.c.\n");
+        fprintf(pfile, "# freq phi  att  pp samples hash\n");
+        for (idx = 0; idx < work.cnt; ++idx) {
+            const struct golden_t * pc = &work.pcfgs[idx];
+            fprintf(pfile, "%04X %04X %04X %u %05lX %08lX%08lX\n", (unsigned int)pc->freq, (unsigned int)pc->phi,
+                (unsigned int)pc->att, (unsigned int)pc->pp, pc->n, pc->hash.hi, pc->hash.lo);
+        }
+        fclose(pfile);
+    }
+
+    for (idx = 0; idx < work.cnt; ++idx) {
+        const struct golden_t * pc = &work.pcfgs[idx];
+        samples += pc->n;
+        if (!update && (pc->hash.hi != pc->ref.hi || pc->hash.lo != pc->ref.lo)) {
+            printf("MISMATCH freq %04X phi %04X att %04X pp %u: %08lX%08lX, expected %08lX%08lX\n",
+                (unsigned int)pc->freq, (unsigned int)pc->phi, (unsigned int)pc->att, (unsigned int)pc->pp,
+                pc->hash.hi, pc->hash.lo, pc->ref.hi, pc->ref.lo);
+            ++bad;
+        }
+    }
+    printf("%lu configurations, %lu samples, %lu mismatches, %.3f s\n", (unsigned long)work.cnt, samples, bad,
+        (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9);
+    if (work.pcache != NULL) {
+        ppc_stats(work.pcache, &hits, &misses, &evicts);
+        printf("cache of %lu entries: %lu hits, %lu misses, %lu evictions\n", entries, hits, misses, evicts);
+    }
+    pthread_mutex_destroy(&work.cache_lock);
+    free(pents);
+    free(ptab);
+    free(work.pcfgs);
+
+    return bad == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
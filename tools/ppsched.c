@@ -0,0 +1,337 @@
+/**@file
+ * @brief   The postprocessing schedule compiler application.
+ * @details The schedule compiler runs the lookahead of the postprocessing offline for each tone of a test plan, and
+ *  writes the schedule table described in \c ppsched.h, either as a C source to be compiled into the target, or as a
+ *  binary blob of little-endian 16-bit words. The target attaches the table with \c gen_set_sched and replays the
+ *  postprocessing intervals of the planned tones; built with GEN_NO_LOOKAHEAD defined, it has no lookahead at all.
+ * @details Usage: ppsched [-b] [-n name] [-o file] plan
+ *  - -b        -- writes the binary blob instead of the C source.
+ *  - name      -- name of the array in the C source; pp_sched by default.
+ *  - file      -- file receiving the table; the standard output stream if omitted.
+ *  - plan      -- test plan: a text file with a tone per line, given with the fields freq, phi, att and optionally pp,
+ *      which is 1 by default. Numbers are decimal or hexadecimal with the 0x prefix. Lines starting with # are
+ *      comments.
+ *
+ * @details Each tone is compiled from the restart: the intervals are collected in the order the generator runs them,
+ *  until the lookahead fails, or the interval starts at a phase where one of the previous intervals has started. Then
+ *  the tone is rendered over two periods of the phase with the lookahead and with the schedule, and the outputs are
+ *  compared; the table is not written if they differ. Statistics are printed to the standard error stream.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "ppsched.h"
+#include "sinegen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* The schedules are the results of the lookahead, so the compiler needs the library built with it. */
+#ifdef GEN_NO_LOOKAHEAD
+#error "ppsched shall be built without GEN_NO_LOOKAHEAD"
+#endif
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define PPS_BLOCK       (0x1000)            /**< Number of samples rendered by one call. */
+#define PPS_LINE        (256)               /**< Maximum length of a line of the plan, in characters. */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for the table being compiled.
+ */
+struct table_t {
+    ui16_t *pwords;                     /**< Words of the table. */
+    ui32_t  size;                       /**< Number of words. */
+    ui32_t  cap;                        /**< Number of words allocated. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Appends a word to the table.
+ * @param[in,out]   pt  -- pointer to the table.
+ * @param[in]       w   -- word.
+ * @return  The status: 0 if appended, non-zero if out of memory.
+ */
+static int put(struct table_t * const pt, const ui16_t w) {
+
+    if (pt->size == pt->cap) {
+        ui32_t  cap = pt->cap ? 2 * pt->cap : 0x1000;
+        ui16_t *pwords = realloc(pt->pwords, cap * sizeof(*pwords));
+        if (pwords == NULL) {
+            return -1;
+        }
+        pt->pwords = pwords;
+        pt->cap = cap;
+    }
+    pt->pwords[pt->size++] = w;
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Appends the entry for the lookahead just run by a generator.
+ * @param[in,out]   pt      -- pointer to the table.
+ * @param[in]       pgen    -- pointer to the generator.
+ * @return  The status: 0 if appended, non-zero if out of memory.
+ */
+static int put_entry(struct table_t * const pt, const struct gen_descr_t * const pgen) {
+
+    int     err = put(pt, pgen->phi0);
+
+    if (pgen->pp) {
+        err |= put(pt, pgen->phi1);
+        err |= put(pt, (ui16_t)pgen->val1);
+        err |= put(pt, pgen->sampl);
+        err |= put(pt, pgen->steps);
+        err |= put(pt, pgen->msize);
+        err |= put(pt, pgen->asize);
+        err |= put(pt, pgen->ridx);
+        err |= put(pt, pgen->aidx);
+    } else {
+        int     idx;
+        for (idx = 1; idx < SCHED_ENTRY; ++idx) {
+            err |= put(pt, 0);
+        }
+    }
+
+    return err;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Compiles the schedule of a tone.
+ * @param[in,out]   pt      -- pointer to the table.
+ * @param[in,out]   pgen    -- pointer to the generator configured with the tone.
+ * @param[in,out]   pseen   -- array of 2^16 indices of the entries by phi0, plus 1; filled with zeros.
+ * @return  The number of entries; 0 if out of memory or too many entries.
+ */
+static unsigned long compile(struct table_t * const pt, struct gen_descr_t * const pgen, ui32_t * const pseen) {
+
+    const ui32_t head = pt->size;       /* Index of the tone header. */
+    unsigned long   cnt = 0;
+    ui16_t  loop = 0;
+
+    if (put(pt, pgen->freq) | put(pt, pgen->phi) | put(pt, pgen->att) | put(pt, pgen->en) | put(pt, 0) |
+            put(pt, 0)) {
+        return 0;
+    }
+    while (1) {
+        if (cnt == 0xFFFFu || put_entry(pt, pgen) != 0) {
+            cnt = 0;
+            break;
+        }
+        ++cnt;
+        if (pgen->pp == 0) {            /* The lookahead has failed, or the generator is paused. */
+            break;
+        }
+        pseen[pgen->phi0] = cnt;
+        gen_skip(pgen, pgen->sampl);    /* Up to the end of the interval, where the next lookahead runs. */
+        if (pgen->pp && pseen[pgen->phi0] != 0) {
+            loop = (ui16_t)(pseen[pgen->phi0] - 1);
+            break;
+        }
+    }
+
+    pt->pwords[head + SCHED_CNT] = (ui16_t)cnt;
+    pt->pwords[head + SCHED_LOOP] = loop;
+    for (cnt = 0; cnt < pt->pwords[head + SCHED_CNT]; ++cnt) {
+        pseen[pt->pwords[head + SCHED_TONE + cnt * SCHED_ENTRY + SCHED_PHI0]] = 0;
+    }
+
+    return pt->pwords[head + SCHED_CNT];
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Checks that a tone renders the same with the lookahead and with the schedule.
+ * @param[in]   pgen    -- pointer to the generator configured with the tone.
+ * @param[in]   ptab    -- pointer to the table.
+ * @return  The status: 0 if the outputs are the same, non-zero otherwise.
+ */
+static int verify(const struct gen_descr_t * const pgen, const ui16_t * const ptab) {
+
+    static sq015_t  ref[PPS_BLOCK], out[PPS_BLOCK];
+    struct gen_descr_t  gen = *pgen, rep = *pgen;
+    unsigned long   n;
+
+    gen_set_sched(&rep, ptab);
+    if (rep.ptone == NULL) {
+        return -1;
+    }
+    n = pgen->freq == 0 ? PPS_BLOCK : 2 * (0x10000uL / (pgen->freq & -pgen->freq));
+    for (; n > 0; n -= n < PPS_BLOCK ? n : PPS_BLOCK) {
+        const ui16_t cnt = n < PPS_BLOCK ? (ui16_t)n : PPS_BLOCK;
+        gen_render(&gen, ref, cnt);
+        gen_render(&rep, out, cnt);
+        if (memcmp(ref, out, cnt * sizeof(*ref)) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Writes the table as a C source.
+ * @param[in,out]   pfile   -- output file.
+ * @param[in]       pt      -- pointer to the table.
+ * @param[in]       name    -- name of the array.
+ * @param[in]       plan    -- name of the test plan.
+ */
+static void write_c(FILE * const pfile, const struct table_t * const pt, const char * const name,
+    const char * const plan) {
+
+    ui32_t  pos = SCHED_HEAD, idx;
+    ui16_t  tone;
+
+    fprintf(pfile, "/* Postprocessing schedules compiled by ppsched from %s; see ppsched.h. */\n", plan);
+    fprintf(pfile, "#include \"ppsched.h\"\n\n");
+    fprintf(pfile, "const ui32_t %s_size = %luuL;\n\n", name, (unsigned long)pt->size);
+    fprintf(pfile, "const ui16_t %s[] = {\n    0x%04X, 0x%04X, 0x%04X,\n", name, pt->pwords[0], pt->pwords[1],
+        pt->pwords[2]);
+    for (tone = 0; tone < pt->pwords[2]; ++tone) {
+        const ui16_t * ph = pt->pwords + pos;
+        fprintf(pfile, "    /* freq 0x%04X, phi 0x%04X, att 0x%04X, pp %u: %u entries, loop to %u. */\n",
+            ph[SCHED_FREQ], ph[SCHED_PHI], ph[SCHED_ATT], ph[SCHED_EN], ph[SCHED_CNT], ph[SCHED_LOOP]);
+        for (idx = 0; idx < SCHED_TONE + (ui32_t)ph[SCHED_CNT] * SCHED_ENTRY; ++idx) {
+            const int last = idx < SCHED_TONE ? idx + 1 == SCHED_TONE : (idx - SCHED_TONE) % SCHED_ENTRY + 1 ==
+                SCHED_ENTRY;
+            fprintf(pfile, "%s0x%04X,%s", idx == 0 || idx == SCHED_TONE || (idx > SCHED_TONE &&
+                (idx - SCHED_TONE) % SCHED_ENTRY == 0) ? "    " : " ", ph[idx], last ? "\n" : "");
+        }
+        pos += SCHED_TONE + (ui32_t)ph[SCHED_CNT] * SCHED_ENTRY;
+    }
+    fprintf(pfile, "};\n");
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+int main(int argc, char * argv[]) {
+
+    static ui32_t   seen[0x10000];      /* Indices of the entries of the current tone by phi0, plus 1. */
+    struct table_t  tab;                /* Table being compiled. */
+    struct gen_descr_t  gen;            /* Generator running the lookahead. */
+    char    line[PPS_LINE];             /* Line of the plan. */
+    FILE *  pplan, * pout = stdout;
+    const char * name = "pp_sched", * out = NULL;
+    unsigned long   tones = 0, entries = 0, lineno = 0;
+    int     opt, bin = 0, err = 0, fail = 0;
+    ui32_t  idx;
+
+    while ((opt = getopt(argc, argv, "bn:o:")) != -1) {
+        switch (opt) {
+        case 'b': bin = 1; break;
+        case 'n': name = optarg; break;
+        case 'o': out = optarg; break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind + 1 != argc) {
+        fprintf(stderr, "\nUsage: %s [-b] [-n name] [-o file] plan\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    pplan = fopen(argv[optind], "r");
+    if (pplan == NULL) {
+        fprintf(stderr, "\nERROR: Failed to open file: %s\n\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    memset(&tab, 0, sizeof(tab));
+    err = put(&tab, SCHED_MAGIC) | put(&tab, SCHED_VERSION) | put(&tab, 0);
+    while (err == 0 && fail == 0 && fgets(line, sizeof(line), pplan) != NULL) {
+        unsigned long   vals[4] = { 0, 0, 0, 1 };   /* freq, phi, att and pp of the tone. */
+        unsigned long   cnt;
+        char *  pos = line;
+        int     fields;
+
+        ++lineno;
+        for (fields = 0; fields < 4; ++fields) {
+            char *  end;
+            const unsigned long val = strtoul(pos, &end, 0);
+            if (end == pos) {
+                break;
+            }
+            vals[fields] = val;
+            pos = end;
+        }
+        if (line[strspn(line, " \t")] == '#' || (fields == 0 && pos[strspn(pos, " \t\r\n")] == '\0')) {
+            continue;
+        }
+        if (fields < 3 || pos[strspn(pos, " \t\r\n")] != '\0' || vals[0] > 0x4000 || vals[1] > 0xFFFF ||
+                vals[2] > 0xFFFF || vals[3] > 1) {
+            fprintf(stderr, "\nERROR: Invalid tone at line %lu: %s\n\n", lineno, argv[optind]);
+            fail = 1;
+            continue;
+        }
+        gen_init(&gen);
+        gen_set_freq(&gen, (uq016_t)vals[0]);
+        gen_set_phi(&gen, (uq016_t)vals[1]);
+        gen_set_att(&gen, (uq016_t)vals[2]);
+        gen_set_pp(&gen, (bool_t)vals[3]);
+        {
+            const struct gen_descr_t tone = gen;    /* Generator right after the restart. */
+            cnt = compile(&tab, &gen, seen);
+            ++(tab.pwords[2]);
+            if (cnt == 0 || tab.pwords[2] == 0) {
+                fprintf(stderr, "\nERROR: Failed to compile the tone at line %lu: %s\n\n", lineno, argv[optind]);
+                fail = 1;
+                continue;
+            }
+            /* An equal tone found earlier in the table has the same schedule, so either one is verified. */
+            if (verify(&tone, tab.pwords) != 0) {
+                fprintf(stderr, "\nERROR: Replay differs from the lookahead at line %lu: %s\n\n", lineno,
+                    argv[optind]);
+                fail = 1;
+                continue;
+            }
+        }
+        ++tones;
+        entries += cnt;
+    }
+    fclose(pplan);
+    if (fail == 0 && err != 0) {
+        fprintf(stderr, "\nERROR: Out of memory\n\n");
+        fail = 1;
+    }
+    if (fail == 0 && sched_check(tab.pwords, tab.size) != 0) {
+        fprintf(stderr, "\nERROR: The compiled table is malformed\n\n");
+        fail = 1;
+    }
+
+    if (fail == 0 && out != NULL) {
+        pout = fopen(out, bin ? "wb" : "w");
+        if (pout == NULL) {
+            fprintf(stderr, "\nERROR: Failed to create file: %s\n\n", out);
+            fail = 1;
+        }
+    }
+    if (fail == 0) {
+        if (bin) {
+            for (idx = 0; idx < tab.size; ++idx) {
+                fputc(tab.pwords[idx] & 0xFF, pout);
+                fputc(tab.pwords[idx] >> 8, pout);
+            }
+        } else {
+            write_c(pout, &tab, name, argv[optind]);
+        }
+        if (pout != stdout && fclose(pout) != 0) {
+            fprintf(stderr, "\nERROR: Failed to write file: %s\n\n", out);
+            fail = 1;
+        }
+    }
+    if (fail == 0) {
+        fprintf(stderr, "%lu tones, %lu entries, %lu words, verified\n", tones, entries, (unsigned long)tab.size);
+    }
+    free(tab.pwords);
+
+    return fail == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
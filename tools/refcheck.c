@@ -0,0 +1,494 @@
+/**@file
+ * @brief   The per-sample reference check application.
+ * @details The reference check application renders pseudo-random configurations of the block renderers of the library,
+ *  and compares every sample with a reference evaluated sample by sample from the definition given in the interface
+ *  of the renderer. Each configuration is rendered in two blocks of different sizes, so the state carried from one
+ *  call to the next is checked, too. The configurations are drawn from a fixed seed, so every run checks the same
+ *  ones.
+ * @details Usage: refcheck [-r rounds] [suite...]
+ *  - rounds    -- number of configurations of each suite; REF_ROUNDS by default.
+ *  - suite     -- suite to run; all suites by default:
+ *      - harm  -- \c harm_render against the sum of \c msin_sq015 over the partials.
+ *      - poly  -- \c poly_render against \c msin_sq015 at the phase of each channel, stored with \c fmt_convert.
+ *      - burst -- \c burst_render against the output of \c gen_render, gated sample by sample.
+ *      - fmt   -- \c gen_render_fmt against \c gen_render and \c fmt_convert, sample by sample.
+ *      - bank  -- \c bank_render against \c gen_render and \c fmt_convert of each channel, sample by sample.
+ *      - meter -- \c tm_result against the bin of the discrete Fourier transform of the samples fed to the meter,
+ *          within the error bound given in \c tonemeter.h.
+ *
+ * @details Mismatches are printed to the standard output stream, and the status is non-zero if there is any.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "burst.h"
+#include "fixtrig.h"
+#include "genbank.h"
+#include "harmgen.h"
+#include "polygen.h"
+#include "sampfmt.h"
+#include "tonemeter.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define REF_ROUNDS      (200)               /**< Default number of configurations of a suite. */
+#define REF_SAMPLES     (5000)              /**< Number of samples or frames rendered for a configuration. */
+#define REF_REPORT      (8)                 /**< Maximum number of mismatches printed for a suite. */
+#define REF_BURST       (60000)             /**< Number of samples rendered for a tone burst. */
+#define REF_FILL        (0xA5)              /**< Byte filling the output frames before they are rendered. */
+#define REF_TM_AMP      (2.0)               /**< Bound of the error of the measured amplitude, see \c tm_result. */
+#define REF_TM_PHI      (3.0)               /**< Bound of the error of the measured phase at the full scale. */
+#define REF_TM_PHI_AMP  (4096.0)            /**< Bound of the error of the measured phase times the amplitude. */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for the result of a suite.
+ */
+struct result_t {
+    const char * name;                  /**< Name of the suite. */
+    unsigned long   cfgs;               /**< Number of configurations rendered. */
+    unsigned long   samples;            /**< Number of samples compared. */
+    unsigned long   bad;                /**< Number of samples which differ from the reference. */
+};
+
+/**@brief   Type of a function running a suite.
+ * @param[in,out]   pr      -- pointer to the result of the suite.
+ * @param[in]       rounds  -- number of configurations to render.
+ */
+typedef void (*suite_t)(struct result_t * const pr, const unsigned long rounds);
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static unsigned long seed;              /**< State of the pseudo-random generator. */
+
+/**@brief   Returns the next pseudo-random number.
+ * @return  A number in the range [0; 2^16).
+ */
+static unsigned long rnd(void) {
+
+    seed = (seed * 1103515245uL + 12345uL) & 0xFFFFFFFFuL;
+
+    return seed >> 16;
+}
+
+/**@brief   Counts a compared sample, and reports it if it differs from the reference.
+ * @param[in,out]   pr      -- pointer to the result of the suite.
+ * @param[in]       match   -- equals to 1 if the sample matches the reference.
+ * @param[in]       what    -- description of the configuration, printed with the mismatch.
+ * @param[in]       idx     -- index of the sample.
+ */
+static void count(struct result_t * const pr, const int match, const char * const what, const unsigned long idx) {
+
+    ++(pr->samples);
+    if (!match) {
+        if (pr->bad < REF_REPORT) {
+            printf("MISMATCH %s: %s, sample %lu\n", pr->name, what, idx);
+        }
+        ++(pr->bad);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Checks the harmonic series generator.
+ * @param[in,out]   pr      -- pointer to the result of the suite.
+ * @param[in]       rounds  -- number of configurations to render.
+ * @details The partials get random attenuations, from loud enough to saturate the sum to silent, and random phase
+ *  offsets; every seventh configuration has the fundamental silent.
+ */
+static void suite_harm(struct result_t * const pr, const unsigned long rounds) {
+
+    static sq015_t  out[REF_SAMPLES];
+    struct harm_descr_t h;
+    uq016_t atts[HARM_MAX], offs[HARM_MAX];
+    char    what[64];
+    unsigned long   r, t;
+    ui16_t  n0;
+    int     k;
+
+    for (r = 0; r < rounds; ++r, ++(pr->cfgs)) {
+        const uq016_t freq = (uq016_t)(r & 1 ? rnd() & 0x3FFF : rnd() % 40);
+        const uq016_t phi = (uq016_t)rnd();
+        harm_init(&h);
+        harm_set_freq(&h, freq);
+        harm_set_phi(&h, phi);
+        for (k = 1; k <= HARM_MAX; ++k) {
+            const unsigned long sel = rnd();
+            if (r % 7 == 0 && k == 1) {
+                atts[k - 1] = 0xFFFF;                           /* Silent. */
+            } else if (sel & 1) {
+                atts[k - 1] = (uq016_t)(0xC000 + (rnd() & 0x3FFF));    /* A quarter of the full scale at most. */
+            } else if (k == 1 && (sel & 2) == 0) {
+                atts[k - 1] = 0;                                /* The full scale, so the sum saturates. */
+            } else {
+                atts[k - 1] = 0xFFFF;
+            }
+            offs[k - 1] = (uq016_t)rnd();
+            harm_set_partial(&h, (ui8_t)k, atts[k - 1], offs[k - 1]);
+        }
+        n0 = (ui16_t)(rnd() % REF_SAMPLES);
+        harm_render(&h, out, n0);
+        harm_render(&h, out + n0, REF_SAMPLES - n0);
+
+        sprintf(what, "freq %04X phi %04X", (unsigned int)freq, (unsigned int)phi);
+        for (t = 0; t < REF_SAMPLES; ++t) {
+            long    sum = 0;
+            for (k = 1; k <= HARM_MAX; ++k) {
+                if (atts[k - 1] != 0xFFFF) {
+                    sum += msin_sq015((uq016_t)(k * (phi + t * freq) + offs[k - 1]), atts[k - 1]);
+                }
+            }
+            sum = sum > 0x7FFFL ? 0x7FFFL : sum < -0x8000L ? -0x8000L : sum;     /* Saturated to SQ0.15. */
+            count(pr, out[t] == sum, what, t);
+        }
+        count(pr, h.phi == (uq016_t)(phi + REF_SAMPLES * freq), what, REF_SAMPLES);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Checks the multi-phase generator.
+ * @param[in,out]   pr      -- pointer to the result of the suite.
+ * @param[in]       rounds  -- number of configurations to render.
+ * @details The configurations cover every number of channels and every output format. Every fifth one has a
+ *  frequency which divides the period, and every third one starts just before the peak, so the phases of pi/2 and
+ *  3*pi/2, where the antiphase channels are evaluated again, are hit.
+ */
+static void suite_poly(struct result_t * const pr, const unsigned long rounds) {
+
+    static const uq016_t atts[] = { 0x0000, 0x0001, 0x1000, 0xFFF0, 0xFFFE, 0xFFFF };
+    static ui32_t   out[REF_SAMPLES * POLY_MAX_CHANS];  /* Frames; ui32_t aligns them for every format. */
+    struct poly_descr_t p;
+    struct fmt_descr_t  fmt;
+    ui32_t  ref;                        /* Reference sample, in the output format. */
+    char    what[64];
+    unsigned long   r, t;
+    ui16_t  n0;
+    size_t  size;                       /* Size of a sample, in bytes. */
+
+    for (r = 0; r < rounds; ++r, ++(pr->cfgs)) {
+        const ui8_t chans = (ui8_t)(r % POLY_MAX_CHANS + 1);
+        const uq016_t freq = (uq016_t)(r % 5 == 0 ? 0x4000 / (1 + rnd() % 8) : r & 1 ? rnd() & 0x3FFF : rnd() % 40);
+        const uq016_t phi = (uq016_t)(r % 3 == 0 ? 0x4000 - (rnd() % 4) * freq : rnd());
+        const uq016_t att = atts[rnd() % ARRAY_SIZE(atts)];
+        fmt.type = (ui8_t)(r / POLY_MAX_CHANS % 5);
+        fmt.chans = 1;
+        fmt.chan = 0;
+        size = fmt_size(fmt.type);
+        poly_init(&p, chans);
+        poly_set_freq(&p, freq);
+        poly_set_phi(&p, phi);
+        poly_set_att(&p, att);
+        n0 = (ui16_t)(rnd() % REF_SAMPLES);
+        poly_render(&p, fmt.type, out, n0);
+        poly_render(&p, fmt.type, (ui8_t *)out + n0 * chans * size, REF_SAMPLES - n0);
+
+        sprintf(what, "chans %u type %u freq %04X phi %04X att %04X", (unsigned int)chans, (unsigned int)fmt.type,
+            (unsigned int)freq, (unsigned int)phi, (unsigned int)att);
+        for (t = 0; t < REF_SAMPLES * chans; ++t) {
+            const unsigned long c = t % chans;
+            const sq015_t x = msin_sq015((uq016_t)(phi + t / chans * freq + (c << 16) / chans), att);
+            fmt_convert(&fmt, &x, &ref, 1);
+            count(pr, memcmp((ui8_t *)out + t * size, &ref, size) == 0, what, t);
+        }
+        count(pr, p.phi == (uq016_t)(phi + REF_SAMPLES * freq), what, REF_SAMPLES * chans);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Checks the tone-burst gate.
+ * @param[in,out]   pr      -- pointer to the result of the suite.
+ * @param[in]       rounds  -- number of configurations to render.
+ * @details The gated generator is rendered in blocks of random sizes, and a copy of it is rendered ungated as the
+ *  reference. The sample t is open if the phase advanced since the start of its period is less than the open part:
+ *  - phase continuity  -- the period starts every (on+off) cycles of the phase t*freq, and the open samples are the
+ *      ones of the copy, which runs through the closed parts, too.
+ *  - phase reset       -- the period starts every ceil((on+off)*2^16/freq) samples, and each burst repeats the first
+ *      samples of the copy.
+ *  - frequency 0       -- the gate stays open, and the output is the one of the copy.
+ *
+ * The modes take turns, with and without the postprocessing.
+ */
+static void suite_burst(struct result_t * const pr, const unsigned long rounds) {
+
+    static sq015_t  out[REF_BURST], ref[REF_BURST];
+    struct gen_descr_t  gen, copy;
+    struct burst_descr_t    b;
+    char    what[96];
+    unsigned long   r, t, idx;
+    ui16_t  cnt;
+
+    for (r = 0; r < rounds; ++r, ++(pr->cfgs)) {
+        const int mode = (int)(r % 3);      /* 0 for phase continuity, 1 for phase reset, 2 for the frequency 0. */
+        const uq016_t freq = (uq016_t)(mode == 2 ? 0 : r & 8 ? 2 + rnd() % 0x3FFE : 2 + rnd() % 60);
+        const uq016_t phi = (uq016_t)rnd();
+        const uq016_t att = (uq016_t)(r & 16 ? 0xF000 : rnd());
+        const ui16_t on = (ui16_t)(1 + rnd() % 5), off = (ui16_t)(rnd() % 4);
+        const bool_t reset = (bool_t)(mode == 1 || (mode == 2 && (r & 1)));
+        const unsigned long on16 = (unsigned long)on << 16, period = ((unsigned long)on + off) << 16;
+        gen_init(&gen);
+        gen_set_freq(&gen, freq);
+        gen_set_phi(&gen, phi);
+        gen_set_att(&gen, att);
+        gen_set_pp(&gen, (bool_t)(r >> 2 & 1));
+        copy = gen;
+        burst_init(&b, &gen, on, off, reset);
+        for (idx = 0; idx < REF_BURST; idx += cnt) {
+            cnt = (ui16_t)(1 + rnd() % 3000);
+            cnt = cnt < REF_BURST - idx ? cnt : (ui16_t)(REF_BURST - idx);
+            burst_render(&b, out + idx, cnt);
+        }
+
+        sprintf(what, "mode %d freq %04X phi %04X att %04X pp %u on %u off %u", mode, (unsigned int)freq,
+            (unsigned int)phi, (unsigned int)att, (unsigned int)(r >> 2 & 1), (unsigned int)on, (unsigned int)off);
+        if (mode == 1) {
+            const unsigned long len = (period + freq - 1) / freq;  /* Number of samples of a period. */
+            gen_render(&copy, ref, (ui16_t)(len < REF_BURST ? len : REF_BURST));
+            for (t = 0; t < REF_BURST; ++t) {
+                const unsigned long m = t % len;
+                count(pr, out[t] == (m * freq < on16 ? ref[m] : 0), what, t);
+            }
+        } else {
+            for (idx = 0; idx < REF_BURST; idx += cnt) {
+                cnt = REF_BURST - idx < 0xFFFFu ? (ui16_t)(REF_BURST - idx) : 0xFFFFu;
+                gen_render(&copy, ref + idx, cnt);
+            }
+            for (t = 0; t < REF_BURST; ++t) {
+                /* t*freq stays below 2^32, since REF_BURST*0x4000 does. */
+                count(pr, out[t] == ((t * freq) % period < on16 ? ref[t] : 0), what, t);
+            }
+            if (mode == 0) {
+                count(pr, copy.phi == gen.phi && copy.sidx == gen.sidx && copy.pp == gen.pp, what, REF_BURST);
+            }
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Checks the rendering into an output format.
+ * @param[in,out]   pr      -- pointer to the result of the suite.
+ * @param[in]       rounds  -- number of configurations to render.
+ * @details The frames are filled with REF_FILL beforehand, and a copy of the generator is rendered one sample at a
+ *  time into a second buffer filled the same way, so the bytes of the other channels, which shall stay untouched,
+ *  are compared, too. The configurations cover every output format and position within the frame, with and without
+ *  the postprocessing.
+ */
+static void suite_fmt(struct result_t * const pr, const unsigned long rounds) {
+
+    static ui32_t   out[REF_SAMPLES * 8], ref[REF_SAMPLES * 8];     /* Frames of up to 8 channels of 4 bytes. */
+    struct gen_descr_t  gen, copy;
+    struct fmt_descr_t  fmt;
+    char    what[96];
+    unsigned long   r, t, bytes;
+    ui16_t  n0;
+    sq015_t x;
+
+    for (r = 0; r < rounds; ++r, ++(pr->cfgs)) {
+        const uq016_t freq = (uq016_t)(r & 1 ? rnd() & 0x3FFF : rnd() % 40);
+        const uq016_t phi = (uq016_t)rnd();
+        const uq016_t att = (uq016_t)(r & 2 ? 0xF000 + (rnd() & 0x0FFF) : rnd());
+        fmt.type = (ui8_t)(r % 5);
+        fmt.chans = (ui8_t)(1 + rnd() % 8);
+        fmt.chan = (ui8_t)(rnd() % fmt.chans);
+        bytes = (unsigned long)REF_SAMPLES * fmt.chans * fmt_size(fmt.type);
+        gen_init(&gen);
+        gen_set_freq(&gen, freq);
+        gen_set_phi(&gen, phi);
+        gen_set_att(&gen, att);
+        gen_set_pp(&gen, (bool_t)(r >> 2 & 1));
+        copy = gen;
+        memset(out, REF_FILL, bytes);
+        memset(ref, REF_FILL, bytes);
+        n0 = (ui16_t)(rnd() % REF_SAMPLES);
+        gen_render_fmt(&gen, &fmt, out, n0);
+        gen_render_fmt(&gen, &fmt, (ui8_t *)out + (unsigned long)n0 * fmt.chans * fmt_size(fmt.type),
+            REF_SAMPLES - n0);
+        for (t = 0; t < REF_SAMPLES; ++t) {
+            gen_render(&copy, &x, 1);
+            fmt_convert(&fmt, &x, (ui8_t *)ref + t * fmt.chans * fmt_size(fmt.type), 1);
+        }
+
+        sprintf(what, "type %u chans %u chan %u freq %04X phi %04X att %04X pp %u", (unsigned int)fmt.type,
+            (unsigned int)fmt.chans, (unsigned int)fmt.chan, (unsigned int)freq, (unsigned int)phi,
+            (unsigned int)att, (unsigned int)(r >> 2 & 1));
+        for (t = 0; t < REF_SAMPLES * fmt.chans; ++t) {     /* Every sample of the frames, of any channel. */
+            const unsigned long pos = t * fmt_size(fmt.type);
+            count(pr, memcmp((ui8_t *)out + pos, (ui8_t *)ref + pos, fmt_size(fmt.type)) == 0, what, t);
+        }
+        count(pr, copy.phi == gen.phi && copy.sidx == gen.sidx && copy.pp == gen.pp, what, REF_SAMPLES * fmt.chans);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Checks the generator bank.
+ * @param[in,out]   pr      -- pointer to the result of the suite.
+ * @param[in]       rounds  -- number of configurations to render.
+ * @details The bank of 2 to 64 channels with random generators is rendered in blocks of random sizes, and a copy of
+ *  each generator renders its channel as a whole, which is stored into the reference frames with \c fmt_convert. The
+ *  configurations cover every output format, with and without the postprocessing.
+ */
+static void suite_bank(struct result_t * const pr, const unsigned long rounds) {
+
+    static ui32_t   out[REF_SAMPLES * BANK_MAX_CHANS], ref[REF_SAMPLES * BANK_MAX_CHANS];   /* Frames of 4 bytes. */
+    static sq015_t  x[REF_SAMPLES];
+    static struct gen_descr_t   gens[BANK_MAX_CHANS], copies[BANK_MAX_CHANS];
+    struct bank_descr_t bank;
+    struct fmt_descr_t  fmt;
+    char    what[64];
+    unsigned long   r, t, idx, frame;
+    ui16_t  cnt;
+    int     same;
+
+    for (r = 0; r < rounds; ++r, ++(pr->cfgs)) {
+        fmt.type = (ui8_t)(r % 5);
+        fmt.chans = (ui8_t)(2 + rnd() % (BANK_MAX_CHANS - 1));
+        frame = (unsigned long)fmt.chans * fmt_size(fmt.type);
+        bank_init(&bank, gens, fmt.chans);
+        for (fmt.chan = 0; fmt.chan < fmt.chans; ++fmt.chan) {
+            gen_set_freq(&gens[fmt.chan], (uq016_t)(rnd() & 1 ? rnd() & 0x3FFF : rnd() % 40));
+            gen_set_phi(&gens[fmt.chan], (uq016_t)rnd());
+            gen_set_att(&gens[fmt.chan], (uq016_t)(rnd() & 1 ? 0xF000 + (rnd() & 0x0FFF) : rnd()));
+            gen_set_pp(&gens[fmt.chan], (bool_t)(r >> 2 & 1));
+            copies[fmt.chan] = gens[fmt.chan];
+        }
+        memset(out, REF_FILL, REF_SAMPLES * frame);
+        memset(ref, REF_FILL, REF_SAMPLES * frame);
+        for (idx = 0; idx < REF_SAMPLES; idx += cnt) {
+            cnt = (ui16_t)(1 + rnd() % (r & 8 ? 100 : 3000));
+            cnt = cnt < REF_SAMPLES - idx ? cnt : (ui16_t)(REF_SAMPLES - idx);
+            bank_render(&bank, fmt.type, (ui8_t *)out + idx * frame, cnt);
+        }
+        same = 1;
+        for (fmt.chan = 0; fmt.chan < fmt.chans; ++fmt.chan) {
+            gen_render(&copies[fmt.chan], x, REF_SAMPLES);
+            fmt_convert(&fmt, x, ref, REF_SAMPLES);
+            same &= copies[fmt.chan].phi == gens[fmt.chan].phi && copies[fmt.chan].sidx == gens[fmt.chan].sidx &&
+                copies[fmt.chan].pp == gens[fmt.chan].pp;
+        }
+
+        sprintf(what, "type %u chans %u pp %u", (unsigned int)fmt.type, (unsigned int)fmt.chans,
+            (unsigned int)(r >> 2 & 1));
+        for (t = 0; t < REF_SAMPLES * fmt.chans; ++t) {
+            const unsigned long pos = t * fmt_size(fmt.type);
+            count(pr, memcmp((ui8_t *)out + pos, (ui8_t *)ref + pos, fmt_size(fmt.type)) == 0, what, t);
+        }
+        count(pr, same, what, REF_SAMPLES * fmt.chans);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Checks the tone meter.
+ * @param[in,out]   pr      -- pointer to the result of the suite.
+ * @param[in]       rounds  -- number of configurations to render.
+ * @details The output of a generator over a random whole number of its periods is fed to the meter in blocks of
+ *  random sizes, and the amplitude and the phase are compared with the ones of the bin of the discrete Fourier
+ *  transform of the same samples, evaluated in double precision. Frequencies are even, so that a period fits into the
+ *  65535 samples the meter accepts; every third one is low. Both the amplitude and the phase count as one sample.
+ */
+static void suite_meter(struct result_t * const pr, const unsigned long rounds) {
+
+    static sq015_t  out[0xFFFF];
+    struct gen_descr_t  gen;
+    struct tm_descr_t   tm;
+    char    what[96];
+    unsigned long   r, t, per, len;
+    uq016_t amp, phi;
+    ui16_t  cnt;
+    double  re, im, ramp, rphi, dphi;
+
+    for (r = 0; r < rounds; ++r, ++(pr->cfgs)) {
+        const uq016_t freq = (uq016_t)(r % 3 == 0 ? 2 + (rnd() & 0x7E) : 2 + (rnd() & 0x3FFC));
+        const uq016_t att = (uq016_t)(r % 5 == 0 ? 0 : r & 1 ? 0xF000 + (rnd() & 0x0FFF) : rnd());
+        const uq016_t phi0 = (uq016_t)rnd();
+        for (per = 0x10000uL, t = freq; (t & 1) == 0; t >>= 1) {
+            per >>= 1;      /* Number of samples of the shortest whole number of periods. */
+        }
+        len = r & 2 ? 0xFFFF / per * per : per * (1 + rnd() % (0xFFFF / per));
+        gen_init(&gen);
+        gen_set_freq(&gen, freq);
+        gen_set_phi(&gen, phi0);
+        gen_set_att(&gen, att);
+        gen_set_pp(&gen, (bool_t)(r >> 2 & 1));
+        gen_render(&gen, out, (ui16_t)len);
+        tm_init(&tm, freq);
+        for (t = 0; t < len; t += cnt) {
+            cnt = (ui16_t)(1 + rnd() % 5000);
+            cnt = cnt < len - t ? cnt : (ui16_t)(len - t);
+            tm_feed(&tm, out + t, cnt);
+        }
+        tm_result(&tm, &amp, &phi);
+
+        re = 0.0;
+        im = 0.0;
+        for (t = 0; t < len; ++t) {
+            const double w = 2 * 3.14159265358979323846 * (double)(t * freq & 0xFFFF) / 0x10000;
+            re += out[t] * sin(w);
+            im += out[t] * cos(w);
+        }
+        ramp = 4.0 * sqrt(re * re + im * im) / len;         /* UQ0.16 amplitude from SQ0.15 samples: 2*2*|v|/N. */
+        ramp = ramp < 0xFFFF ? ramp : 0xFFFF;
+        rphi = atan2(im, re) / (2 * 3.14159265358979323846) * 0x10000;
+        dphi = fmod(phi - rphi + 1.5 * 0x10000, 0x10000) - 0x8000;
+
+        sprintf(what, "freq %04X phi %04X att %04X pp %u len %lu: amp %04X phi %04X, ref %.2f %.2f",
+            (unsigned int)freq, (unsigned int)phi0, (unsigned int)att, (unsigned int)(r >> 2 & 1), len,
+            (unsigned int)amp, (unsigned int)phi, ramp, rphi < 0 ? rphi + 0x10000 : rphi);
+        count(pr, fabs(amp - ramp) <= REF_TM_AMP, what, 0);
+        count(pr, ramp < 1.0 || fabs(dphi) <= REF_TM_PHI + REF_TM_PHI_AMP / ramp, what, 1);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if all samples match the references, non-zero otherwise.
+ */
+int main(int argc, char * argv[]) {
+
+    static const char * const names[] = { "harm", "poly", "burst", "fmt", "bank", "meter" };
+    static const suite_t suites[] = { suite_harm, suite_poly, suite_burst, suite_fmt, suite_bank, suite_meter };
+    struct result_t res;
+    unsigned long   rounds = REF_ROUNDS, bad = 0;
+    size_t  idx;
+    int     opt, arg;
+
+    while ((opt = getopt(argc, argv, "r:")) != -1) {
+        switch (opt) {
+        case 'r': rounds = strtoul(optarg, NULL, 0); break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    for (arg = optind; arg < argc; ++arg) {
+        for (idx = 0; idx < ARRAY_SIZE(names) && strcmp(argv[arg], names[idx]) != 0; ++idx) {
+        }
+        if (idx == ARRAY_SIZE(names)) {
+            fprintf(stderr, "\nUsage: %s [-r rounds] [suite...]\n\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (idx = 0; idx < ARRAY_SIZE(names); ++idx) {
+        for (arg = optind; arg < argc && strcmp(argv[arg], names[idx]) != 0; ++arg) {
+        }
+        if (optind < argc && arg == argc) {
+            continue;
+        }
+        memset(&res, 0, sizeof(res));
+        res.name = names[idx];
+        seed = 1 + idx;
+        suites[idx](&res, rounds);
+        printf("%s: %lu configurations, %lu samples, %lu mismatches\n", res.name, res.cfgs, res.samples, res.bad);
+        bad += res.bad;
+    }
+
+    return bad == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,113 @@
+/**@file
+ * @brief   The ring reader application.
+ * @details The ring reader application attaches to a shared memory ring written by the capture application and copies
+ *  the consumed blocks into a file or to the standard output stream, until the ring is closed. It is the reference
+ *  consumer of the ring: analyzers and loggers follow the same sequence of calls and process blocks in place.
+ * @details Usage: ringcat [-t timeout] ring [file]
+ *  - timeout   -- time to wait for the ring to appear, in milliseconds; 5000 by default.
+ *  - ring      -- name of the ring, e.g. /tone.
+ *  - file      -- output file; the standard output stream if omitted.
+ *
+ * @details Blocks overwritten while they are copied are dropped. Statistics of the reader are printed to the standard
+ *  error stream.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "sampfmt.h"
+#include "shmring.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+int main(int argc, char * argv[]) {
+
+    struct ring_info_t  info;       /* Parameters of the ring. */
+    struct ring_stats_t stats;      /* Statistics of the reader. */
+    struct ring_t * pr = NULL;      /* Reader of the ring. */
+    FILE *  pfile = stdout;         /* Output file. */
+    unsigned long   timeout = 5000, frames = 0;
+    const void * pblk;
+    void *  buf;
+    size_t  frame;
+    ui16_t  n;
+    int     opt;
+
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        switch (opt) {
+        case 't': timeout = strtoul(optarg, NULL, 0); break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc - 1 && optind != argc - 2) {
+        fprintf(stderr, "\nUsage: %s [-t timeout] ring [file]\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    while (1) {
+        struct timespec ts;
+        pr = ring_attach(argv[optind], &info);
+        if (pr != NULL || errno != ENOENT || timeout < 10) {
+            break;
+        }
+        ts.tv_sec = 0;
+        ts.tv_nsec = 10000000;
+        nanosleep(&ts, NULL);
+        timeout -= 10;
+    }
+    if (pr == NULL) {
+        fprintf(stderr, "\nERROR: Failed to attach to ring: %s: %s\n\n", argv[optind], strerror(errno));
+        return EXIT_FAILURE;
+    }
+    if (optind == argc - 2) {
+        pfile = fopen(argv[optind + 1], "wb");
+        if (pfile == NULL) {
+            fprintf(stderr, "\nERROR: Failed to create file: %s\n\n", argv[optind + 1]);
+            ring_detach(pr, NULL);
+            return EXIT_FAILURE;
+        }
+    }
+
+    frame = (size_t)fmt_size(info.type) * info.chans;
+    buf = malloc(frame * info.block);
+    if (buf == NULL) {
+        ring_detach(pr, NULL);
+        return EXIT_FAILURE;
+    }
+    while ((pblk = ring_acquire(pr, &n)) != NULL) {
+        /* The block is copied out before it is released, so that a block overwritten during the copy never reaches the
+         * file. */
+        memcpy(buf, pblk, n * frame);
+        if (ring_release(pr) == 0) {
+            fwrite(buf, frame, n, pfile);
+            frames += n;
+        }
+    }
+    ring_detach(pr, &stats);
+    free(buf);
+    if (pfile != stdout) {
+        fclose(pfile);
+    }
+
+    fprintf(stderr, "%lu frames  blocks %8lu  lost %8lu  waits %8lu  wait %8.3f s\n", frames, stats.blocks, stats.lost,
+        stats.waits, stats.wait);
+
+    return EXIT_SUCCESS;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,154 @@
+/**@file
+ * @brief   The shard merging application.
+ * @details The shard merging application combines the partial result files of the shards of a sweep into the result
+ *  file of the whole sweep, see \c shard.h. The files may be given in any order; all of them shall belong to the same
+ *  sweep, and each shard of it shall be given exactly once. The comment lines of the shard 0 are kept, and the item
+ *  lines of the shards are interleaved in the order of the items, so the result is the same as the unsharded sweep
+ *  writes.
+ * @details Usage: shardmerge [-o file] part...
+ *  - file      -- file receiving the merged results; the standard output stream if omitted.
+ *  - part      -- partial result file of a shard.
+ *
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "shard.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define MERGE_LINE      (4096)              /**< Maximum length of a line, in characters. */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for a partial result file.
+ */
+struct part_t {
+    FILE *  pfile;                      /**< File. */
+    const char * name;                  /**< Name of the file. */
+    struct shard_t  shard;              /**< Header of the file. */
+    char    line[MERGE_LINE];           /**< Line read ahead. */
+    int     more;                       /**< Equals to 1 if the line read ahead is valid. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Reads the next line of a partial result file.
+ * @param[in,out]   pp  -- pointer to the partial result file.
+ * @return  The status: 0 if a line is read or the file is over, non-zero if the line is too long.
+ */
+static int part_next(struct part_t * const pp) {
+
+    pp->more = fgets(pp->line, sizeof(pp->line), pp->pfile) != NULL;
+
+    return pp->more && strchr(pp->line, '\n') == NULL && !feof(pp->pfile);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+int main(int argc, char * argv[]) {
+
+    struct part_t * parts;              /* Partial result files, indexed by the shard. */
+    struct part_t   part;               /* Partial result file being opened. */
+    struct shard_t  whole;              /* Header of the merged file. */
+    FILE *  pout = stdout;              /* Merged file. */
+    const char * out = NULL;
+    unsigned long   n, k, idx;
+    int     opt, arg;
+
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        switch (opt) {
+        case 'o': out = optarg; break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind == argc) {
+        fprintf(stderr, "\nUsage: %s [-o file] part...\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    n = (unsigned long)(argc - optind);
+    parts = calloc(n, sizeof(*parts));
+    if (parts == NULL) {
+        return EXIT_FAILURE;
+    }
+    for (arg = optind; arg < argc; ++arg) {
+        memset(&part, 0, sizeof(part));
+        part.name = argv[arg];
+        part.pfile = fopen(part.name, "r");
+        if (part.pfile == NULL || shard_read(part.pfile, &part.shard) != 0) {
+            fprintf(stderr, "\nERROR: Not a partial result file: %s\n\n", part.name);
+            return EXIT_FAILURE;
+        }
+        k = part.shard.k;
+        if (part.shard.n != n || parts[k].pfile != NULL ||
+                (arg > optind && (strcmp(part.shard.job, whole.job) != 0 || part.shard.total != whole.total))) {
+            fprintf(stderr, "\nERROR: Shard %lu/%lu of %s, %lu items, does not fit: %s\n\n", k, part.shard.n,
+                part.shard.job, part.shard.total, part.name);
+            return EXIT_FAILURE;
+        }
+        whole = part.shard;
+        parts[k] = part;
+    }
+    whole.k = 0;
+    whole.n = 1;
+
+    if (out != NULL) {
+        pout = fopen(out, "w");
+        if (pout == NULL) {
+            fprintf(stderr, "\nERROR: Failed to create file: %s\n\n", out);
+            return EXIT_FAILURE;
+        }
+    }
+    shard_write(pout, &whole);
+    for (k = 0; k < n; ++k) {           /* Comments follow the header; those of the shard 0 are kept. */
+        do {
+            if (part_next(&parts[k]) != 0) {
+                fprintf(stderr, "\nERROR: Line too long: %s\n\n", parts[k].name);
+                return EXIT_FAILURE;
+            }
+            if (k == 0 && parts[k].more && parts[k].line[0] == '#') {
+                fputs(parts[k].line, pout);
+            }
+        } while (parts[k].more && parts[k].line[0] == '#');
+    }
+    for (idx = 0; idx < whole.total; ++idx) {
+        struct part_t * pp = &parts[idx % n];
+        if (!pp->more) {
+            fprintf(stderr, "\nERROR: Item %lu is missing: %s\n\n", idx, pp->name);
+            return EXIT_FAILURE;
+        }
+        fputs(pp->line, pout);
+        if (part_next(pp) != 0) {
+            fprintf(stderr, "\nERROR: Line too long: %s\n\n", pp->name);
+            return EXIT_FAILURE;
+        }
+    }
+    for (k = 0; k < n; ++k) {
+        if (parts[k].more) {
+            fprintf(stderr, "\nERROR: Extra items: %s\n\n", parts[k].name);
+            return EXIT_FAILURE;
+        }
+        fclose(parts[k].pfile);
+    }
+    if (pout != stdout && fclose(pout) != 0) {
+        fprintf(stderr, "\nERROR: Failed to write file: %s\n\n", out);
+        return EXIT_FAILURE;
+    }
+    free(parts);
+
+    return EXIT_SUCCESS;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
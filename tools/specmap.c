@@ -0,0 +1,469 @@
+/**@file
+ * @brief   The spectral quality map application.
+ * @details The spectral quality map application measures the spurious-free dynamic range (SFDR) and the total harmonic
+ *  distortion (THD) of the generator output over a grid of frequencies and attenuations, with the postprocessing
+ *  disabled and enabled, so it shows where the output breaks down at low levels and how much the postprocessing helps.
+ * @details Each configuration is captured over exactly one period of the phase, P = 2^16 / (freq & -freq) samples,
+ *  after the lead-in of one period which follows a restart. The capture then holds a whole number of cycles of the
+ *  tone, and its discrete Fourier transform has no leakage: the tone is in the bin m = freq / (freq & -freq), and every
+ *  other bin holds a spur. P is a power of two, so the transform is a radix-2 FFT. Configurations are processed by a
+ *  pool of threads, each with its own buffers.
+ *  - SFDR  -- the ratio of the power of the tone to the power of the largest other bin, including DC, in dB.
+ *  - THD   -- the ratio of the power of the harmonics 2 to SPEC_HARM, folded into the first Nyquist zone, to the power
+ *              of the tone, in dB.
+ *
+ * @details The frequencies of the grid are spaced logarithmically from 1 to 0x4000, and so are the amplitudes 1-att
+ *  from 1 down to 2^-16, since the low levels are the interesting ones. The value SPEC_NONE stays for an undefined
+ *  result: the output is silent, or the configuration is skipped. The frequency 1 is skipped with the postprocessing
+ *  enabled: its lookahead may exceed the domain of \c sqrt_ui16.
+ * @details Usage: specmap [-j threads] [-f freqs] [-a atts] [-s shard] [-r results] [-c results] [-o map]
+ *  - threads   -- number of threads; the number of online processors by default.
+ *  - freqs     -- number of frequencies of the grid; 256 by default.
+ *  - atts      -- number of attenuations of the grid; 256 by default.
+ *  - shard     -- shard of the grid in the form k/N, see \c shard.h; the whole grid by default.
+ *  - -r        -- reads the results from the given CSV file instead of computing them, e.g. merged shards.
+ *  - -c        -- writes the results into the given CSV file.
+ *  - -o        -- writes the results into the given binary map file; not allowed for a shard.
+ *
+ * @details The CSV file has a line per configuration: freq; att; pp; SFDR; THD, after the shard header and a comment
+ *  with the size of the grid. The values have 9 significant digits, so the map read back from merged shards is the
+ *  same as the map of the whole grid. The binary map file consists of:
+ *  - the 8-byte signature SPECMAP1, then the numbers of frequencies and attenuations, 32-bit each;
+ *  - the codes of the frequencies and of the attenuations, 16-bit each;
+ *  - SFDR as 32-bit floating point values, indexed by [pp][freq][att], then THD in the same layout.
+ *
+ * @details Integers of the map are little endian, and floating point values are stored in the byte order of the host.
+ *  A summary of the worst results for each octave of the amplitude is printed to the standard output stream.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "shard.h"
+#include "sinegen.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define SPEC_FFT        (0x10000uL)         /**< Largest size of the transform - i.e., the longest period. */
+#define SPEC_HARM       (10)                /**< Highest harmonic counted by THD. */
+#define SPEC_NONE       (-999.0)            /**< Value of an undefined result. */
+#define SPEC_THREADS    (64)                /**< Maximum number of threads. */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for the map.
+ */
+struct map_t {
+    unsigned long   nf;                 /**< Number of frequencies. */
+    unsigned long   na;                 /**< Number of attenuations. */
+    uq016_t * freqs;                    /**< Frequencies of the grid. */
+    uq016_t * atts;                     /**< Attenuations of the grid. */
+    float * sfdr;                       /**< SFDR of each configuration, in dB, indexed by [pp][freq][att]. */
+    float * thd;                        /**< THD of each configuration, in dB, in the same layout. */
+};
+
+/**@brief   Data structure for the work shared by the threads.
+ */
+struct work_t {
+    pthread_mutex_t lock;               /**< Lock protecting the index of the next item. */
+    struct map_t *  pmap;               /**< Map. */
+    struct shard_t  shard;              /**< Shard of the grid. */
+    unsigned long   next;               /**< Index of the next item of the shard. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Table of cos(2*pi*k/SPEC_FFT), for k from 0 to 3/4 of SPEC_FFT; the sine is read a quarter later.
+ */
+static double twiddles[SPEC_FFT / 4 * 3];
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Transforms a complex sequence in place.
+ * @param[in,out]   re      -- real parts.
+ * @param[in,out]   im      -- imaginary parts.
+ * @param[in]       n       -- size of the sequence, a power of two not greater than SPEC_FFT.
+ * @details This is the iterative radix-2 decimation in time FFT with the forward sign of the exponent.
+ */
+static void fft(double * const re, double * const im, const unsigned long n) {
+
+    unsigned long   i, j, k, bit, len, step;
+    double  wr, wi, tr, ti;
+
+    for (i = 1, j = 0; i < n; ++i) {
+        for (bit = n >> 1; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            tr = re[i], re[i] = re[j], re[j] = tr;
+            ti = im[i], im[i] = im[j], im[j] = ti;
+        }
+    }
+    for (len = 2; len <= n; len <<= 1) {
+        step = SPEC_FFT / len;
+        for (k = 0; k < len / 2; ++k) {
+            wr = twiddles[k * step];
+            wi = twiddles[k * step + SPEC_FFT / 4];         /* -sin(x) = cos(x + pi/2). */
+            for (i = k; i < n; i += len) {
+                j = i + len / 2;
+                tr = re[j] * wr - im[j] * wi;
+                ti = re[j] * wi + im[j] * wr;
+                re[j] = re[i] - tr;
+                im[j] = im[i] - ti;
+                re[i] += tr;
+                im[i] += ti;
+            }
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Measures a configuration.
+ * @param[in]   freq    -- frequency.
+ * @param[in]   att     -- attenuation.
+ * @param[in]   pp      -- postprocessing status.
+ * @param[out]  re      -- buffer of SPEC_FFT real parts.
+ * @param[out]  im      -- buffer of SPEC_FFT imaginary parts.
+ * @param[out]  psfdr   -- pointer to the variable receiving SFDR, in dB.
+ * @param[out]  pthd    -- pointer to the variable receiving THD, in dB.
+ */
+static void measure(const uq016_t freq, const uq016_t att, const bool_t pp, double * const re, double * const im,
+    float * const psfdr, float * const pthd) {
+
+    const unsigned long period = 0x10000uL / (freq & -freq);   /* Period of the phase, in samples. */
+    const unsigned long m = freq / (freq & -freq);              /* Bin of the tone. */
+    struct gen_descr_t  gen;            /* Generator. */
+    sq015_t buf[0x1000];                /* Block of samples. */
+    unsigned long   idx, cnt, bin;
+    double  tone, spur = 0, harm = 0, pw;
+    int     h;
+
+    *psfdr = (float)SPEC_NONE;
+    *pthd = (float)SPEC_NONE;
+    if (freq == 1 && pp) {
+        return;
+    }
+    memset(&gen, 0, sizeof(gen));
+    gen_init(&gen);
+    gen_set_freq(&gen, freq);
+    gen_set_att(&gen, att);
+    gen_set_pp(&gen, pp);
+    for (idx = 0; idx < 2 * period; idx += cnt) {
+        cnt = 2 * period - idx < ARRAY_SIZE(buf) ? 2 * period - idx : ARRAY_SIZE(buf);
+        gen_render(&gen, buf, (ui16_t)cnt);
+        for (bin = 0; bin < cnt; ++bin) {
+            if (idx + bin >= period) {      /* The lead-in is dropped. */
+                re[idx + bin - period] = buf[bin];
+                im[idx + bin - period] = 0;
+            }
+        }
+    }
+
+    fft(re, im, period);
+    tone = re[m] * re[m] + im[m] * im[m];
+    for (bin = 0; bin <= period / 2; ++bin) {
+        pw = re[bin] * re[bin] + im[bin] * im[bin];
+        spur = bin != m && pw > spur ? pw : spur;
+    }
+    for (h = 2; h <= SPEC_HARM; ++h) {
+        bin = h * m % period;
+        bin = bin > period / 2 ? period - bin : bin;
+        harm += bin != m ? re[bin] * re[bin] + im[bin] * im[bin] : 0;
+    }
+    if (tone > 0) {
+        *psfdr = spur > 0 ? (float)(10 * log10(tone / spur)) : (float)HUGE_VAL;
+        *pthd = harm > 0 ? (float)(10 * log10(harm / tone)) : (float)-HUGE_VAL;
+    }
+}
+
+/**@brief   Measures items of the shard until there are none left.
+ * @param[in,out]   arg     -- pointer to the shared work.
+ * @return  NULL.
+ */
+static void * worker(void * arg) {
+
+    struct work_t * pw = arg;
+    struct map_t *  pm = pw->pmap;
+    double * re = malloc(2 * SPEC_FFT * sizeof(double));       /* Real parts, then imaginary parts. */
+    unsigned long   j, idx;
+
+    if (re == NULL) {
+        return NULL;
+    }
+    for (;;) {
+        pthread_mutex_lock(&pw->lock);
+        j = pw->next < shard_items(&pw->shard) ? pw->next++ : (unsigned long)-1;
+        pthread_mutex_unlock(&pw->lock);
+        if (j == (unsigned long)-1) {
+            free(re);
+            return NULL;
+        }
+        idx = j * pw->shard.n + pw->shard.k;
+        measure(pm->freqs[idx / pm->na % pm->nf], pm->atts[idx % pm->na], (bool_t)(idx / (pm->nf * pm->na)),
+            re, re + SPEC_FFT, &pm->sfdr[idx], &pm->thd[idx]);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Allocates the map and builds the grid.
+ * @param[out]  pm      -- pointer to the map, with the numbers of frequencies and attenuations set.
+ * @return  The status: 0 if the map is allocated, non-zero otherwise.
+ */
+static int map_alloc(struct map_t * const pm) {
+
+    unsigned long   idx;
+    double  x;
+
+    pm->freqs = malloc(pm->nf * sizeof(uq016_t));
+    pm->atts = malloc(pm->na * sizeof(uq016_t));
+    pm->sfdr = malloc(2 * pm->nf * pm->na * sizeof(float));
+    pm->thd = malloc(2 * pm->nf * pm->na * sizeof(float));
+    if (pm->freqs == NULL || pm->atts == NULL || pm->sfdr == NULL || pm->thd == NULL) {
+        return -1;
+    }
+    for (idx = 0; idx < pm->nf; ++idx) {        /* From 1 to 0x4000; increasing where the spacing is below 1. */
+        x = floor(pow(2.0, 14.0 * idx / (pm->nf - 1)) + 0.5);
+        x = idx > 0 && x <= pm->freqs[idx - 1] ? pm->freqs[idx - 1] + 1 : x;
+        pm->freqs[idx] = (uq016_t)(x < 0x4000 ? x : 0x4000);
+    }
+    for (idx = 0; idx < pm->na; ++idx) {        /* Amplitudes from 1 down to 2^-16. */
+        x = 0x10000 - floor(pow(2.0, 16.0 - 16.0 * idx / (pm->na - 1)) + 0.5);
+        pm->atts[idx] = (uq016_t)x;
+    }
+
+    return 0;
+}
+
+/**@brief   Reads the results from a CSV file.
+ * @param[in]   name    -- name of the file.
+ * @param[out]  pm      -- pointer to the map.
+ * @return  The status: 0 if the results are read, non-zero otherwise.
+ */
+static int map_read(const char * const name, struct map_t * const pm) {
+
+    FILE *  pfile = fopen(name, "r");
+    struct shard_t  shard;
+    char    line[128];                  /* Line of the file. */
+    unsigned long   idx, freq, att, pp;
+    double  sfdr, thd;
+    int     res = -1;
+
+    if (pfile == NULL) {
+        return -1;
+    }
+    if (shard_read(pfile, &shard) == 0 && shard.n == 1 && strcmp(shard.job, "specmap") == 0) {
+        pm->nf = 0;
+        while (fgets(line, sizeof(line), pfile) != NULL && line[0] == '#') {
+            sscanf(line, "# grid %lu x %lu", &pm->nf, &pm->na);
+        }
+        res = pm->nf < 2 || pm->na < 2 || shard.total != 2 * pm->nf * pm->na || map_alloc(pm) != 0;
+        for (idx = 0; idx < shard.total && res == 0; ++idx) {
+            res = (idx > 0 && fgets(line, sizeof(line), pfile) == NULL) ||
+                sscanf(line, "%lu; %lu; %lu; %lf; %lf", &freq, &att, &pp, &sfdr, &thd) != 5 ||
+                freq != pm->freqs[idx / pm->na % pm->nf] || att != pm->atts[idx % pm->na];
+            pm->sfdr[idx] = (float)sfdr;
+            pm->thd[idx] = (float)thd;
+        }
+    }
+    fclose(pfile);
+
+    return res;
+}
+
+/**@brief   Writes the results of a shard into a CSV file.
+ * @param[in]   name    -- name of the file.
+ * @param[in]   pm      -- pointer to the map.
+ * @param[in]   psh     -- pointer to the shard.
+ * @return  The status: 0 if the results are written, non-zero otherwise.
+ */
+static int map_write_csv(const char * const name, const struct map_t * const pm, const struct shard_t * const psh) {
+
+    FILE *  pfile = fopen(name, "w");
+    unsigned long   j, idx;
+
+    if (pfile == NULL) {
+        return -1;
+    }
+    shard_write(pfile, psh);
+    fprintf(pfile, "# grid %lu x %lu, see tools/specmap.c\n", pm->nf, pm->na);
+    fprintf(pfile, "# freq; att; pp; SFDR, dB; THD, dB\n");
+    for (j = 0; j < shard_items(psh); ++j) {
+        idx = j * psh->n + psh->k;
+        fprintf(pfile, "%u; %u; %u; %.9g; %.9g\n", (unsigned int)pm->freqs[idx / pm->na % pm->nf],
+            (unsigned int)pm->atts[idx % pm->na], (unsigned int)(idx / (pm->nf * pm->na)), pm->sfdr[idx],
+            pm->thd[idx]);
+    }
+
+    return fclose(pfile);
+}
+
+/**@brief   Writes the map into a binary file.
+ * @param[in]   name    -- name of the file.
+ * @param[in]   pm      -- pointer to the map.
+ * @return  The status: 0 if the map is written, non-zero otherwise.
+ */
+static int map_write_bin(const char * const name, const struct map_t * const pm) {
+
+    FILE *  pfile = fopen(name, "wb");
+    ui8_t   hdr[16];
+    unsigned long   idx;
+
+    if (pfile == NULL) {
+        return -1;
+    }
+    memcpy(hdr, "SPECMAP1", 8);
+    for (idx = 0; idx < 4; ++idx) {
+        hdr[8 + idx] = (ui8_t)(pm->nf >> (8 * idx));
+        hdr[12 + idx] = (ui8_t)(pm->na >> (8 * idx));
+    }
+    fwrite(hdr, 1, sizeof(hdr), pfile);
+    for (idx = 0; idx < pm->nf + pm->na; ++idx) {
+        const uq016_t x = idx < pm->nf ? pm->freqs[idx] : pm->atts[idx - pm->nf];
+        fputc(x & 0xFF, pfile);
+        fputc(x >> 8, pfile);
+    }
+    fwrite(pm->sfdr, sizeof(float), 2 * pm->nf * pm->na, pfile);
+    fwrite(pm->thd, sizeof(float), 2 * pm->nf * pm->na, pfile);
+
+    return fclose(pfile);
+}
+
+/**@brief   Prints the worst results for each octave of the amplitude.
+ * @param[in]   pm      -- pointer to the map.
+ */
+static void map_summary(const struct map_t * const pm) {
+
+    unsigned long   a, f, idx, cnt;
+    int     oct, pp;
+    float   sfdr[2], thd[2];
+
+    printf("amplitude     | pp 0: min SFDR  max THD | pp 1: min SFDR  max THD\n");
+    for (oct = 0; oct <= 16; ++oct) {
+        sfdr[0] = sfdr[1] = (float)HUGE_VAL;
+        thd[0] = thd[1] = (float)-HUGE_VAL;
+        for (a = 0, cnt = 0; a < pm->na; ++a) {
+            if ((int)floor(-log(1 - pm->atts[a] / 65536.0) / log(2.0) + 1e-9) != oct) {
+                continue;
+            }
+            for (pp = 0; pp < 2; ++pp) {
+                for (f = 0; f < pm->nf; ++f) {
+                    idx = (pp * pm->nf + f) * pm->na + a;
+                    if (pm->sfdr[idx] != (float)SPEC_NONE) {
+                        sfdr[pp] = pm->sfdr[idx] < sfdr[pp] ? pm->sfdr[idx] : sfdr[pp];
+                        thd[pp] = pm->thd[idx] > thd[pp] ? pm->thd[idx] : thd[pp];
+                        ++cnt;
+                    }
+                }
+            }
+        }
+        if (cnt > 0) {
+            printf("%4d..%4d dB |   %12.2f %8.2f |   %12.2f %8.2f\n", -6 * oct, -6 * (oct + 1), sfdr[0], thd[0],
+                sfdr[1], thd[1]);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+int main(int argc, char * argv[]) {
+
+    static pthread_t    thr[SPEC_THREADS];  /* Threads. */
+    struct map_t    map;                    /* Map. */
+    struct work_t   work;                   /* Shared work. */
+    struct timespec t0, t1;                 /* Start and end time of the measurement. */
+    unsigned long   threads = (unsigned long)sysconf(_SC_NPROCESSORS_ONLN), idx;
+    const char * in = NULL;
+    const char * csv = NULL;
+    const char * bin = NULL;
+    int     opt, err = 0;
+
+    memset(&map, 0, sizeof(map));
+    memset(&work, 0, sizeof(work));
+    strcpy(work.shard.job, "specmap");
+    work.shard.n = 1;
+    map.nf = 256;
+    map.na = 256;
+    while ((opt = getopt(argc, argv, "j:f:a:s:r:c:o:")) != -1) {
+        switch (opt) {
+        case 'j': threads = strtoul(optarg, NULL, 0); break;
+        case 'f': map.nf = strtoul(optarg, NULL, 0); break;
+        case 'a': map.na = strtoul(optarg, NULL, 0); break;
+        case 's': err = shard_parse(optarg, &work.shard); break;
+        case 'r': in = optarg; break;
+        case 'c': csv = optarg; break;
+        case 'o': bin = optarg; break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc || err != 0 || threads == 0 || threads > SPEC_THREADS || map.nf < 2 || map.nf > 0x4000 ||
+            map.na < 2 || map.na > 0x10000uL || (bin != NULL && work.shard.n > 1) || (in != NULL && work.shard.n > 1)) {
+        fprintf(stderr, "\nUsage: %s [-j threads] [-f freqs] [-a atts] [-s k/N] [-r results] [-c results] [-o map]\n\n",
+            argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (in != NULL) {
+        if (map_read(in, &map) != 0) {
+            fprintf(stderr, "\nERROR: Failed to read results: %s\n\n", in);
+            return EXIT_FAILURE;
+        }
+        work.shard.total = 2 * map.nf * map.na;     /* The results are the ones of the whole map. */
+    } else {
+        if (map_alloc(&map) != 0) {
+            fprintf(stderr, "\nERROR: Not enough memory\n\n");
+            return EXIT_FAILURE;
+        }
+        for (idx = 0; idx < ARRAY_SIZE(twiddles); ++idx) {
+            twiddles[idx] = cos(2 * 3.14159265358979323846 * idx / SPEC_FFT);
+        }
+        work.pmap = &map;
+        work.shard.total = 2 * map.nf * map.na;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        pthread_mutex_init(&work.lock, NULL);
+        for (idx = 0; idx + 1 < threads && err == 0; ++idx) {
+            err = pthread_create(&thr[idx], NULL, worker, &work);
+        }
+        threads = err == 0 ? idx : idx - 1;
+        worker(&work);                      /* The main thread is one of the threads. */
+        for (idx = 0; idx < threads; ++idx) {
+            pthread_join(thr[idx], NULL);
+        }
+        pthread_mutex_destroy(&work.lock);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (work.next < shard_items(&work.shard)) {
+            fprintf(stderr, "\nERROR: Not enough memory\n\n");
+            return EXIT_FAILURE;
+        }
+        fprintf(stderr, "%lu configurations in %.3f s\n", shard_items(&work.shard),
+            (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9);
+    }
+
+    if (csv != NULL && map_write_csv(csv, &map, &work.shard) != 0) {
+        fprintf(stderr, "\nERROR: Failed to write file: %s\n\n", csv);
+        return EXIT_FAILURE;
+    }
+    if (bin != NULL && map_write_bin(bin, &map) != 0) {
+        fprintf(stderr, "\nERROR: Failed to write file: %s\n\n", bin);
+        return EXIT_FAILURE;
+    }
+    if (work.shard.n == 1) {
+        map_summary(&map);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,231 @@
+/**@file
+ * @brief   The tone client application.
+ * @details The tone client connects to the tone server, sends the commands given in the command line one after another
+ *  and receives the stream of frames into a file. It is the reference client of the protocol described in
+ *  \c toneproto.h, and it is used to test the server locally.
+ * @details Usage: tonecli [-S socket] [-o file] command...
+ *  - socket    -- path of the socket of the server; TONE_SOCKET by default.
+ *  - file      -- file receiving the frames; the standard output stream if omitted.
+ *
+ * @details Commands:
+ *  - config chan freq phi att pp       -- configures a generator.
+ *  - format chans type block batch     -- sets the stream format; type is one of sq015, f32, s24, s32, ob16.
+ *  - start frames                      -- starts rendering; 0 frames to stream endlessly.
+ *  - stop                              -- stops rendering.
+ *  - sub, unsub                        -- subscribes to, or unsubscribes from the stream.
+ *  - recv frames                       -- receives the given number of frames.
+ *  - wait                              -- receives frames until the end of the run.
+ *  - quit                              -- shuts the server down.
+ *
+ * @details Numbers are decimal or hexadecimal with the 0x prefix. Frames which arrive while the client waits for a
+ *  reply are received, too. Statistics are printed to the standard error stream.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "sampfmt.h"
+#include "toneproto.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Names of output sample formats, indexed by FMT_xxx.
+ */
+static const char * const fmt_names[] = { "sq015", "f32", "s24", "s32", "ob16" };
+
+/**@brief   Data structure for the state of the client.
+ */
+struct cli_t {
+    int     fd;                 /**< Socket. */
+    FILE *  pfile;              /**< Output file. */
+    ui8_t * buf;                /**< Buffer of a data message. */
+    size_t  size;               /**< Size of the buffer, in bytes. */
+    unsigned long   frames;     /**< Number of frames received. */
+    unsigned long   limit;      /**< Number of frames to store before the rest is discarded. */
+    unsigned long   msgs;       /**< Number of data messages received. */
+    int     end;                /**< Set to 1 when the end of a run is received. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Receives one message from the server and handles it.
+ * @param[in,out]   pcli    -- pointer to the client state.
+ * @param[out]      pmsg    -- pointer to the structure receiving the header of the message.
+ * @return  The status: 0 if a message is received, non-zero if the server closed the connection.
+ * @details Frames of a data message are stored into the output file up to the limit.
+ */
+static int cli_recv(struct cli_t * const pcli, struct tone_msg_t * const pmsg) {
+
+    ui8_t   hdr[TONE_MSG_SIZE];     /* Encoded header. */
+    size_t  frame;                  /* Size of a frame, in bytes. */
+
+    if (tone_recv(pcli->fd, hdr, TONE_MSG_SIZE) != 0) {
+        return -1;
+    }
+    tone_unpack(hdr, pmsg);
+    if (pmsg->cmd == TONE_END) {
+        pcli->end = 1;
+    }
+    if (pmsg->cmd != TONE_DATA) {
+        return 0;
+    }
+
+    frame = (size_t)fmt_size((ui8_t)pmsg->a) * pmsg->arg;
+    if (frame * pmsg->d > pcli->size) {
+        ui8_t * pbuf = realloc(pcli->buf, frame * pmsg->d);
+        if (pbuf == NULL) {
+            return -1;
+        }
+        pcli->buf = pbuf;
+        pcli->size = frame * pmsg->d;
+    }
+    if (tone_recv(pcli->fd, pcli->buf, frame * pmsg->d) != 0) {
+        return -1;
+    }
+    if (pcli->frames < pcli->limit) {
+        unsigned long n = pcli->limit - pcli->frames < pmsg->d ? pcli->limit - pcli->frames : pmsg->d;
+        fwrite(pcli->buf, frame, n, pcli->pfile);
+        pcli->frames += n;
+    }
+    ++(pcli->msgs);
+
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+int main(int argc, char * argv[]) {
+
+    static const struct {
+        const char * name;      /* Name of the command. */
+        ui8_t   cmd;            /* Command code. */
+        int     args;           /* Number of arguments. */
+    } cmds[] = {
+        { "config", TONE_CONFIG, 5 }, { "format", TONE_FORMAT, 4 }, { "start", TONE_START, 1 },
+        { "stop", TONE_STOP, 0 }, { "sub", TONE_SUBSCRIBE, 0 }, { "unsub", TONE_UNSUBSCRIBE, 0 },
+        { "quit", TONE_QUIT, 0 }, { "recv", 0, 1 }, { "wait", 0, 0 },
+    };
+    struct cli_t    cli;            /* State of the client. */
+    struct sockaddr_un  addr;       /* Address of the socket. */
+    struct tone_msg_t   msg;        /* Header of a message. */
+    const char * path = TONE_SOCKET;
+    const char * out = NULL;
+    unsigned long   args[5];
+    int     opt, arg, idx, cnt;
+
+    while ((opt = getopt(argc, argv, "S:o:")) != -1) {
+        switch (opt) {
+        case 'S': path = optarg; break;
+        case 'o': out = optarg; break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind == argc || strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "\nUsage: %s [-S socket] [-o file] command...\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    memset(&cli, 0, sizeof(cli));
+    cli.pfile = stdout;
+    if (out != NULL) {
+        cli.pfile = fopen(out, "wb");
+        if (cli.pfile == NULL) {
+            fprintf(stderr, "\nERROR: Failed to create file: %s\n\n", out);
+            return EXIT_FAILURE;
+        }
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    cli.fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (cli.fd < 0 || connect(cli.fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "\nERROR: Failed to connect to server: %s: %s\n\n", path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    for (arg = optind; arg < argc; arg += 1 + cmds[idx].args) {
+        for (idx = 0; idx < (int)ARRAY_SIZE(cmds) && strcmp(argv[arg], cmds[idx].name) != 0; ++idx) {
+        }
+        if (idx == (int)ARRAY_SIZE(cmds) || arg + cmds[idx].args >= argc) {
+            fprintf(stderr, "\nERROR: Invalid command: %s\n\n", argv[arg]);
+            return EXIT_FAILURE;
+        }
+        for (cnt = 0; cnt < cmds[idx].args; ++cnt) {
+            args[cnt] = strtoul(argv[arg + 1 + cnt], NULL, 0);
+        }
+        if (cmds[idx].cmd == TONE_FORMAT) {
+            for (args[1] = 0; args[1] < ARRAY_SIZE(fmt_names) && strcmp(argv[arg + 2], fmt_names[args[1]]) != 0;
+                    ++args[1]) {
+            }
+        }
+
+        if (cmds[idx].cmd == 0) {       /* recv or wait: receive frames. */
+            cli.limit = cmds[idx].args > 0 ? cli.frames + args[0] : (unsigned long)-1;
+            cli.end = 0;
+            while (cli.frames < cli.limit && cli.end == 0) {
+                if (cli_recv(&cli, &msg) != 0) {
+                    fprintf(stderr, "\nERROR: Connection closed by server\n\n");
+                    return EXIT_FAILURE;
+                }
+            }
+            continue;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.cmd = cmds[idx].cmd;
+        if (msg.cmd == TONE_CONFIG) {
+            msg.arg = (ui8_t)args[0];
+            msg.a = (ui16_t)args[1];
+            msg.b = (ui16_t)args[2];
+            msg.c = (ui16_t)args[3];
+            msg.d = args[4];
+        } else if (msg.cmd == TONE_FORMAT) {
+            msg.arg = (ui8_t)args[0];
+            msg.a = (ui16_t)args[1];
+            msg.b = (ui16_t)args[2];
+            msg.c = (ui16_t)args[3];
+        } else if (msg.cmd == TONE_START) {
+            msg.d = args[0];
+        }
+        cli.limit = (unsigned long)-1;
+        if (tone_send(cli.fd, &msg, NULL, 0) != 0) {
+            fprintf(stderr, "\nERROR: Failed to send command: %s\n\n", argv[arg]);
+            return EXIT_FAILURE;
+        }
+        do {
+            if (cli_recv(&cli, &msg) != 0) {
+                fprintf(stderr, "\nERROR: Connection closed by server\n\n");
+                return EXIT_FAILURE;
+            }
+        } while (msg.cmd != TONE_ACK);
+        if (msg.arg != TONE_OK) {
+            fprintf(stderr, "\nERROR: Command failed: %s: status %u\n\n", argv[arg], (unsigned int)msg.arg);
+            return EXIT_FAILURE;
+        }
+    }
+
+    close(cli.fd);
+    if (cli.pfile != stdout) {
+        fclose(cli.pfile);
+    }
+    free(cli.buf);
+    fprintf(stderr, "%lu frames in %lu messages\n", cli.frames, cli.msgs);
+
+    return EXIT_SUCCESS;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
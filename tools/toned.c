@@ -0,0 +1,565 @@
+/**@file
+ * @brief   The tone server application.
+ * @details The tone server owns a bank of sine wave generators and serves it to local clients over a Unix domain
+ *  socket with the binary protocol described in \c toneproto.h. Clients configure the generators, start and stop
+ *  rendering, and subscribe to the stream of rendered frames; every subscriber receives the same stream.
+ * @details Usage: toned [-S socket]
+ *  - socket    -- path of the listening socket; TONE_SOCKET by default.
+ *
+ * @details Rendering runs in a separate thread, which fills one buffer while the main thread sends the other one to
+ *  subscribers, so rendering and I/O overlap. Each buffer holds a batch of several blocks and goes to a subscriber as a
+ *  single message. Configuration changes are published through the lock-free mailbox described in \c genmail.h, and
+ *  the render thread picks them up between blocks without taking the lock.
+ * @details The main thread serves all sockets with poll(), and never blocks on a client: the sockets are non-blocking,
+ *  and each client has a queue of outgoing messages, which is sent as fast as the client reads it. A batch is copied
+ *  once into a message shared by the queues of all subscribers, so the buffer returns to the render thread at once. A
+ *  client which falls behind by more than TONED_QUEUE messages or TONED_QUEUE_BYTES bytes is disconnected, so a
+ *  stalled subscriber neither stalls the stream nor the commands of other clients.
+ * @author  agent
+ * @version 1.0
+ * @date    October, 2026
+ * @copyright   GNU Public License
+ */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200112L
+
+#include "genbank.h"
+#include "genmail.h"
+#include "sampfmt.h"
+#include "toneproto.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define TONED_CLIENTS   (32)                /**< Maximum number of connected clients. */
+#define TONED_BUFS      (2)                 /**< Number of batch buffers. */
+#define TONED_MAX_BATCH (16uL << 20)        /**< Maximum size of a batch, in bytes. */
+#define TONED_QUEUE     (16)                /**< Maximum number of messages queued for a client. */
+#define TONED_QUEUE_BYTES   (4 * TONED_MAX_BATCH)   /**< Maximum number of bytes queued for a client. */
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Data structure for an outgoing message, shared by the queues of several clients.
+ */
+struct toned_pkt_t {
+    unsigned int    refs;               /**< Number of queues holding the message. */
+    size_t  size;                       /**< Size of the message, in bytes. */
+    ui8_t   data[1];                    /**< Encoded header followed by the payload; allocated up to size. */
+};
+
+/**@brief   Data structure for a connected client.
+ */
+struct toned_client_t {
+    int     fd;                         /**< Non-blocking socket of the client; -1 if the place is free. */
+    int     sub;                        /**< Equals to 1 if the client is subscribed to the stream. */
+    ui8_t   in[TONE_MSG_SIZE];          /**< Header of the command being received. */
+    size_t  inlen;                      /**< Number of bytes of the header received. */
+    struct toned_pkt_t *outq[TONED_QUEUE];  /**< Queue of outgoing messages. */
+    unsigned int    qhead;              /**< Index of the first message of the queue. */
+    unsigned int    qcount;             /**< Number of messages in the queue. */
+    size_t  qbytes;                     /**< Number of bytes in the queue not yet sent. */
+    size_t  sent;                       /**< Number of bytes of the first message already sent. */
+};
+
+/**@brief   Data structure for the state of the server shared by the main thread and the render thread.
+ */
+struct toned_t {
+    pthread_mutex_t lock;               /**< Lock protecting the state. */
+    pthread_cond_t  cond;               /**< Signalled to wake the render thread. */
+    struct gen_descr_t  gens[BANK_MAX_CHANS];   /**< Generators; owned by the render thread while it renders. */
+    struct mail_t   mail;               /**< Mailbox of configurations of generators; posted under the lock. */
+    struct bank_descr_t bank;           /**< Bank of generators. */
+    ui8_t   type;                       /**< Format of samples. */
+    ui16_t  block;                      /**< Number of frames rendered at once. */
+    ui16_t  batch;                      /**< Number of blocks in a batch. */
+    int     running;                    /**< Equals to 1 while rendering. */
+    int     busy;                       /**< Equals to 1 while the render thread renders a batch. */
+    int     quit;                       /**< Set to 1 when the server shuts down. */
+    int     forever;                    /**< Equals to 1 if the run is endless. */
+    unsigned int    run;                /**< Number of the run, incremented by every start. */
+    unsigned long   left;               /**< Number of frames left in a limited run. */
+    unsigned long   total;              /**< Number of frames rendered in the run. */
+    ui8_t * bufs[TONED_BUFS];           /**< Batch buffers. */
+    unsigned long   frames[TONED_BUFS]; /**< Number of frames in each filled buffer. */
+    unsigned long   totals[TONED_BUFS]; /**< Number of frames rendered in the run up to the end of each buffer. */
+    int     ends[TONED_BUFS];           /**< Equals to 1 if the buffer completes the run. */
+    unsigned int    wr;                 /**< Number of buffers filled. */
+    unsigned int    rd;                 /**< Number of buffers sent. */
+    int     notify[2];                  /**< Pipe used by the render thread to wake the main thread. */
+};
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The render thread function.
+ * @param[in,out]   arg -- pointer to the server state.
+ * @return  NULL.
+ */
+static void * toned_render(void * const arg) {
+
+    struct toned_t * const ps = arg;
+
+    pthread_mutex_lock(&ps->lock);
+    while (1) {
+        size_t  frame;                  /* Size of a frame, in bytes. */
+        int     idx;                    /* Index of the buffer to fill. */
+        unsigned int    run;            /* Number of the run the batch belongs to. */
+        unsigned long   n, done;
+
+        while (ps->quit == 0 && (ps->running == 0 || ps->wr - ps->rd == TONED_BUFS)) {
+            pthread_cond_wait(&ps->cond, &ps->lock);
+        }
+        if (ps->quit) {
+            break;
+        }
+        frame = (size_t)fmt_size(ps->type) * ps->bank.chans;
+        idx = ps->wr % TONED_BUFS;
+        run = ps->run;
+        n = (unsigned long)ps->block * ps->batch;
+        if (ps->forever == 0 && ps->left < n) {
+            n = ps->left;
+        }
+        ps->busy = 1;
+        pthread_mutex_unlock(&ps->lock);
+
+        for (done = 0; done < n; done += ps->block) {
+            mail_take(&ps->mail, &ps->bank);
+            bank_render(&ps->bank, ps->type, ps->bufs[idx] + done * frame,
+                (ui16_t)(n - done < ps->block ? n - done : ps->block));
+        }
+
+        pthread_mutex_lock(&ps->lock);
+        ps->busy = 0;
+        ps->frames[idx] = n;
+        ps->ends[idx] = 0;
+        if (run == ps->run) {
+            ps->total += n;
+        }
+        ps->totals[idx] = ps->total;
+        /* The batch of a run stopped and restarted during rendering is delivered, but it does not count in the run. */
+        if (run == ps->run && ps->forever == 0) {
+            ps->left -= n;
+            if (ps->left == 0) {
+                ps->ends[idx] = 1;
+                ps->running = 0;
+            }
+        }
+        ++(ps->wr);
+        if (write(ps->notify[1], "", 1) < 0) {
+            /* Nothing to do: the main thread flushes all filled buffers whenever it wakes up. */
+        }
+    }
+    pthread_mutex_unlock(&ps->lock);
+
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Creates an outgoing message.
+ * @param[in]   pmsg    -- pointer to the header of the message.
+ * @param[in]   pdata   -- pointer to the payload following the header; may be NULL if \p size is 0.
+ * @param[in]   size    -- size of the payload, in bytes.
+ * @return  Pointer to the message, not held by any queue yet; NULL if out of memory.
+ */
+static struct toned_pkt_t * toned_pkt(const struct tone_msg_t * const pmsg, const void * const pdata,
+    const size_t size) {
+
+    struct toned_pkt_t * ppkt = malloc(sizeof(*ppkt) + TONE_MSG_SIZE + size);
+
+    if (ppkt != NULL) {
+        ppkt->refs = 0;
+        ppkt->size = TONE_MSG_SIZE + size;
+        tone_pack(pmsg, ppkt->data);
+        if (size > 0) {
+            memcpy(ppkt->data + TONE_MSG_SIZE, pdata, size);
+        }
+    }
+
+    return ppkt;
+}
+
+/**@brief   Releases a message held by a queue.
+ * @param[in,out]   ppkt    -- pointer to the message; freed when no queue holds it.
+ */
+static void toned_release(struct toned_pkt_t * const ppkt) {
+
+    if (--(ppkt->refs) == 0) {
+        free(ppkt);
+    }
+}
+
+/**@brief   Disconnects a client and drops its queue.
+ * @param[in,out]   pcl     -- pointer to the client.
+ */
+static void toned_drop(struct toned_client_t * const pcl) {
+
+    close(pcl->fd);
+    pcl->fd = -1;
+    for (; pcl->qcount > 0; --(pcl->qcount)) {
+        toned_release(pcl->outq[pcl->qhead]);
+        pcl->qhead = (pcl->qhead + 1) % TONED_QUEUE;
+    }
+    pcl->qbytes = 0;
+    pcl->sent = 0;
+}
+
+/**@brief   Sends the queue of a client as far as the socket accepts it.
+ * @param[in,out]   pcl     -- pointer to the client; disconnected if the socket fails.
+ */
+static void toned_drain(struct toned_client_t * const pcl) {
+
+    while (pcl->fd >= 0 && pcl->qcount > 0) {
+        struct toned_pkt_t * const ppkt = pcl->outq[pcl->qhead];
+        const ssize_t res = write(pcl->fd, ppkt->data + pcl->sent, ppkt->size - pcl->sent);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                toned_drop(pcl);
+            }
+            return;
+        }
+        pcl->sent += res;
+        pcl->qbytes -= res;
+        if (pcl->sent == ppkt->size) {
+            toned_release(ppkt);
+            pcl->qhead = (pcl->qhead + 1) % TONED_QUEUE;
+            --(pcl->qcount);
+            pcl->sent = 0;
+        }
+    }
+}
+
+/**@brief   Appends a message to the queue of a client and sends what the socket accepts.
+ * @param[in,out]   pcl     -- pointer to the client; disconnected if the queue overflows.
+ * @param[in,out]   ppkt    -- pointer to the message; NULL if it could not be created, which drops the client, too.
+ */
+static void toned_queue(struct toned_client_t * const pcl, struct toned_pkt_t * const ppkt) {
+
+    if (pcl->fd < 0) {
+        return;
+    }
+    if (ppkt == NULL || pcl->qcount == TONED_QUEUE || pcl->qbytes + ppkt->size > TONED_QUEUE_BYTES) {
+        fprintf(stderr, "toned: client dropped: %s\n", ppkt == NULL ? "out of memory" : "send queue overflow");
+        toned_drop(pcl);
+        return;
+    }
+    ++(ppkt->refs);
+    pcl->outq[(pcl->qhead + pcl->qcount) % TONED_QUEUE] = ppkt;
+    ++(pcl->qcount);
+    pcl->qbytes += ppkt->size;
+    toned_drain(pcl);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Queues the filled buffers for subscribers.
+ * @param[in,out]   ps      -- pointer to the server state.
+ * @param[in,out]   pcls    -- pointer to the array of clients.
+ */
+static void toned_flush(struct toned_t * const ps, struct toned_client_t * const pcls) {
+
+    struct tone_msg_t   msg;    /* Header of a message. */
+    struct toned_pkt_t *pdata;  /* Message with the frames of the buffer. */
+    struct toned_pkt_t *pend;   /* Message with the end of the run. */
+    int     cl;                 /* Index of a client. */
+
+    pthread_mutex_lock(&ps->lock);
+    while (ps->rd != ps->wr) {
+        const int idx = ps->rd % TONED_BUFS;
+        const size_t frame = (size_t)fmt_size(ps->type) * ps->bank.chans;
+        pthread_mutex_unlock(&ps->lock);
+
+        pdata = NULL;
+        pend = NULL;
+        for (cl = 0; cl < TONED_CLIENTS; ++cl) {
+            if (pcls[cl].fd < 0 || pcls[cl].sub == 0) {
+                continue;
+            }
+            if (pdata == NULL) {    /* The messages are made once, for the first subscriber. */
+                memset(&msg, 0, sizeof(msg));
+                msg.cmd = TONE_DATA;
+                msg.arg = ps->bank.chans;
+                msg.a = ps->type;
+                msg.d = ps->frames[idx];
+                pdata = toned_pkt(&msg, ps->bufs[idx], ps->frames[idx] * frame);
+                msg.cmd = TONE_END;
+                msg.d = ps->totals[idx];
+                pend = ps->ends[idx] ? toned_pkt(&msg, NULL, 0) : NULL;
+                if (pdata != NULL) {
+                    ++(pdata->refs);    /* Held here until all subscribers have it. */
+                }
+                if (pend != NULL) {
+                    ++(pend->refs);
+                }
+            }
+            toned_queue(&pcls[cl], pdata);
+            if (ps->ends[idx]) {
+                toned_queue(&pcls[cl], pend);
+            }
+        }
+        if (pdata != NULL) {
+            toned_release(pdata);
+        }
+        if (pend != NULL) {
+            toned_release(pend);
+        }
+
+        pthread_mutex_lock(&ps->lock);
+        ++(ps->rd);
+        pthread_cond_signal(&ps->cond);
+    }
+    pthread_mutex_unlock(&ps->lock);
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   Executes a command of a client.
+ * @param[in,out]   ps      -- pointer to the server state.
+ * @param[in,out]   pcl     -- pointer to the client.
+ * @param[in]       pcmd    -- pointer to the command.
+ * @return  The status of the command, one of TONE_xxx codes.
+ */
+static ui8_t toned_exec(struct toned_t * const ps, struct toned_client_t * const pcl,
+    const struct tone_msg_t * const pcmd) {
+
+    ui8_t   status = TONE_OK;   /* Status of the command. */
+    struct gen_params_t prm;    /* Configuration of a generator. */
+
+    pthread_mutex_lock(&ps->lock);
+    switch (pcmd->cmd) {
+    case TONE_CONFIG:
+        if (pcmd->arg >= BANK_MAX_CHANS || pcmd->a > 0x4000 || pcmd->d > 1) {
+            status = TONE_EINVAL;
+            break;
+        }
+        prm.freq = pcmd->a;
+        prm.phi = pcmd->b;
+        prm.att = pcmd->c;
+        prm.en = (bool_t)pcmd->d;
+        mail_set(&ps->mail, (ui8_t)pcmd->arg, &prm);
+        mail_post(&ps->mail);
+        break;
+
+    case TONE_FORMAT:
+        if (pcmd->arg < 1 || pcmd->arg > BANK_MAX_CHANS || pcmd->a > FMT_OB16 || pcmd->b < 1 || pcmd->c < 1 ||
+                (unsigned long)fmt_size((ui8_t)pcmd->a) * pcmd->arg * pcmd->b * pcmd->c > TONED_MAX_BATCH) {
+            status = TONE_EINVAL;
+        } else if (ps->running || ps->busy || ps->rd != ps->wr) {
+            status = TONE_EBUSY;
+        } else {
+            const size_t size = (size_t)fmt_size((ui8_t)pcmd->a) * pcmd->arg * pcmd->b * pcmd->c;
+            int     idx;
+            for (idx = 0; idx < TONED_BUFS; ++idx) {
+                ui8_t * pbuf = realloc(ps->bufs[idx], size);
+                if (pbuf == NULL) {
+                    status = TONE_ENOMEM;
+                    break;
+                }
+                ps->bufs[idx] = pbuf;
+            }
+            if (status == TONE_OK) {
+                bank_init(&ps->bank, ps->gens, pcmd->arg);
+                mail_touch(&ps->mail);      /* Generators are reinitialized, so all configurations are reapplied. */
+                mail_post(&ps->mail);
+                ps->type = (ui8_t)pcmd->a;
+                ps->block = pcmd->b;
+                ps->batch = pcmd->c;
+            }
+        }
+        break;
+
+    case TONE_START:
+        if (ps->running) {
+            status = TONE_EBUSY;
+            break;
+        }
+        ps->forever = pcmd->d == 0;
+        ps->left = pcmd->d;
+        ps->total = 0;
+        ps->running = 1;
+        ++(ps->run);
+        pthread_cond_signal(&ps->cond);
+        break;
+
+    case TONE_STOP:
+        ps->running = 0;
+        break;
+
+    case TONE_SUBSCRIBE:
+    case TONE_UNSUBSCRIBE:
+        pcl->sub = pcmd->cmd == TONE_SUBSCRIBE;
+        break;
+
+    case TONE_QUIT:
+        ps->quit = 1;
+        pthread_cond_signal(&ps->cond);
+        break;
+
+    default:
+        status = TONE_EINVAL;
+        break;
+    }
+    pthread_mutex_unlock(&ps->lock);
+
+    return status;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**@brief   The main application function.
+ * @param[in]   argc    -- number of command line arguments.
+ * @param[in]   argv    -- command line arguments.
+ * @return  The status: 0 if finished successfully, non-zero if there was a failure.
+ */
+int main(int argc, char * argv[]) {
+
+    static struct toned_t   srv;                    /* State of the server. */
+    static struct toned_client_t    cls[TONED_CLIENTS];     /* Clients. */
+    struct pollfd   fds[TONED_CLIENTS + 2];         /* Sockets polled: listening, notification, clients. */
+    int     map[TONED_CLIENTS + 2];                 /* Indices of clients polled. */
+    struct sockaddr_un  addr;                       /* Address of the socket. */
+    const char * path = TONE_SOCKET;
+    pthread_t   thr;
+    int     lsn, opt, cl, cnt, idx, err;
+    char    tmp[64];
+
+    while ((opt = getopt(argc, argv, "S:")) != -1) {
+        switch (opt) {
+        case 'S': path = optarg; break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc || strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "\nUsage: %s [-S socket]\n\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    lsn = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path);
+    if (lsn < 0 || bind(lsn, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(lsn, TONED_CLIENTS) != 0) {
+        fprintf(stderr, "\nERROR: Failed to listen on socket: %s: %s\n\n", path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    pthread_mutex_init(&srv.lock, NULL);
+    mail_init(&srv.mail);
+    pthread_cond_init(&srv.cond, NULL);
+    srv.type = FMT_SQ015;
+    srv.block = 1024;
+    srv.batch = 4;
+    srv.bufs[0] = malloc((size_t)fmt_size(srv.type) * srv.block * srv.batch);
+    srv.bufs[1] = malloc((size_t)fmt_size(srv.type) * srv.block * srv.batch);
+    bank_init(&srv.bank, srv.gens, 1);
+    if (srv.bufs[0] == NULL || srv.bufs[1] == NULL || pipe(srv.notify) != 0) {
+        return EXIT_FAILURE;
+    }
+    err = pthread_create(&thr, NULL, toned_render, &srv);
+    if (err != 0) {
+        fprintf(stderr, "\nERROR: Failed to start render thread: %s\n\n", strerror(err));
+        return EXIT_FAILURE;
+    }
+    for (cl = 0; cl < TONED_CLIENTS; ++cl) {
+        cls[cl].fd = -1;
+    }
+
+    while (srv.quit == 0) {
+        fds[0].fd = lsn;
+        fds[0].events = POLLIN;
+        fds[1].fd = srv.notify[0];
+        fds[1].events = POLLIN;
+        for (cnt = 2, cl = 0; cl < TONED_CLIENTS; ++cl) {
+            if (cls[cl].fd >= 0) {
+                fds[cnt].fd = cls[cl].fd;
+                fds[cnt].events = POLLIN | (cls[cl].qcount > 0 ? POLLOUT : 0);
+                map[cnt++] = cl;
+            }
+        }
+        if (poll(fds, cnt, -1) < 0) {
+            continue;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            if (read(srv.notify[0], tmp, sizeof(tmp)) < 0) {
+                continue;
+            }
+            toned_flush(&srv, cls);
+        }
+
+        for (idx = 2; idx < cnt && srv.quit == 0; ++idx) {
+            struct toned_client_t * const pcl = &cls[map[idx]];
+            ssize_t res;
+            if (pcl->fd < 0 || fds[idx].revents == 0) {    /* The client may be dropped by a flush. */
+                continue;
+            }
+            if (fds[idx].revents & POLLOUT) {
+                toned_drain(pcl);
+            }
+            if (pcl->fd < 0 || (fds[idx].revents & ~POLLOUT) == 0) {
+                continue;
+            }
+            res = read(pcl->fd, pcl->in + pcl->inlen, TONE_MSG_SIZE - pcl->inlen);
+            if (res <= 0) {
+                if (res < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    continue;
+                }
+                toned_drop(pcl);
+                continue;
+            }
+            pcl->inlen += res;
+            if (pcl->inlen == TONE_MSG_SIZE) {
+                struct tone_msg_t   msg;
+                tone_unpack(pcl->in, &msg);
+                pcl->inlen = 0;
+                msg.arg = toned_exec(&srv, pcl, &msg);
+                msg.a = msg.cmd;
+                msg.cmd = TONE_ACK;
+                msg.b = msg.c = 0;
+                msg.d = 0;
+                toned_queue(pcl, toned_pkt(&msg, NULL, 0));
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(lsn, NULL, NULL);
+            for (cl = 0; fd >= 0 && cl < TONED_CLIENTS && cls[cl].fd >= 0; ++cl) {
+            }
+            if (fd < 0 || fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0) {
+                cl = TONED_CLIENTS;
+            }
+            if (cl < TONED_CLIENTS) {
+                cls[cl].fd = fd;
+                cls[cl].sub = 0;
+                cls[cl].inlen = 0;
+            } else if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    pthread_join(thr, NULL);
+    for (cl = 0; cl < TONED_CLIENTS; ++cl) {
+        toned_drain(&cls[cl]);      /* The reply to TONE_QUIT, if the socket accepts it. */
+        if (cls[cl].fd >= 0) {
+            toned_drop(&cls[cl]);
+        }
+    }
+    close(lsn);
+    unlink(path);
+    free(srv.bufs[0]);
+    free(srv.bufs[1]);
+
+    return EXIT_SUCCESS;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*/